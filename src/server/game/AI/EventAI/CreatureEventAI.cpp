@@ -89,6 +89,11 @@ CreatureEventAI::CreatureEventAI(Creature* c) : CreatureAI(c)
         sLog->outError("CreatureEventAI: EventMap for Creature %u is empty but creature is using CreatureEventAI.", me->GetEntry());
 
     m_bEmptyList = m_CreatureEventAIList.empty();
+    m_bHasTimerOOCEvents = false;
+    for (CreatureEventAIList::const_iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+        if ((*i).Event.event_type == EVENT_T_TIMER_OOC)
+            m_bHasTimerOOCEvents = true;
+    m_bEventTimersPending = true;
     m_Phase = 0;
     m_CombatMovementEnabled = true;
     m_MeleeEnabled = true;
@@ -111,6 +116,9 @@ bool CreatureEventAI::ProcessEvent(CreatureEventAIHolder& holder, Unit* actionIn
     if (!holder.Enabled || holder.Time)
         return false;
 
+    //Processing may start the repeat timer
+    m_bEventTimersPending = true;
+
     //Check the inverse phase mask (event doesn't trigger if current phase bit is set in mask)
     if (holder.Event.event_inverse_phase_mask & (1 << m_Phase))
         return false;
@@ -860,6 +868,7 @@ void CreatureEventAI::Reset()
 {
     m_EventUpdateTime = EVENT_UPDATE_TIME;
     m_EventDiff = 0;
+    m_bEventTimersPending = true;
 
     if (m_bEmptyList)
         return;
@@ -993,6 +1002,7 @@ void CreatureEventAI::EnterCombat(Unit* enemy)
 
     m_EventUpdateTime = EVENT_UPDATE_TIME;
     m_EventDiff = 0;
+    m_bEventTimersPending = true;
 }
 
 void CreatureEventAI::AttackStart(Unit* who)
@@ -1068,45 +1078,54 @@ void CreatureEventAI::UpdateAI(const uint32 diff)
         {
             m_EventDiff += diff;
 
-            //Check for time based events
-            for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+            //Without victim, running timers and out of combat timer events there is nothing to check
+            if (m_bEventTimersPending || m_bHasTimerOOCEvents || me->getVictim())
             {
-                //Decrement Timers
-                if ((*i).Time)
+                m_bEventTimersPending = false;
+
+                //Check for time based events
+                for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
                 {
-                    if (m_EventDiff <= (*i).Time)
+                    //Decrement Timers
+                    if ((*i).Time)
                     {
-                        //Do not decrement timers if event cannot trigger in this phase
-                        if (!((*i).Event.event_inverse_phase_mask & (1 << m_Phase)))
-                            (*i).Time -= m_EventDiff;
+                        if (m_EventDiff <= (*i).Time)
+                        {
+                            //Do not decrement timers if event cannot trigger in this phase
+                            if (!((*i).Event.event_inverse_phase_mask & (1 << m_Phase)))
+                                (*i).Time -= m_EventDiff;
 
-                        //Skip processing of events that have time remaining
-                        continue;
+                            if ((*i).Time)
+                                m_bEventTimersPending = true;
+
+                            //Skip processing of events that have time remaining
+                            continue;
+                        }
+                        else (*i).Time = 0;
                     }
-                    else (*i).Time = 0;
-                }
 
-                //Events that are updated every EVENT_UPDATE_TIME
-                switch ((*i).Event.event_type)
-                {
-                    case EVENT_T_TIMER_OOC:
-                        ProcessEvent(*i);
-                        break;
-                    case EVENT_T_TIMER:
-                    case EVENT_T_MANA:
-                    case EVENT_T_HP:
-                    case EVENT_T_TARGET_HP:
-                    case EVENT_T_TARGET_CASTING:
-                    case EVENT_T_FRIENDLY_HP:
-                        if (me->getVictim())
+                    //Events that are updated every EVENT_UPDATE_TIME
+                    switch ((*i).Event.event_type)
+                    {
+                        case EVENT_T_TIMER_OOC:
                             ProcessEvent(*i);
-                        break;
-                    case EVENT_T_RANGE:
-                        if (me->getVictim())
-                            if (me->IsInMap(me->getVictim()))
-                                if (me->IsInRange(me->getVictim(), (float)(*i).Event.range.minDist, (float)(*i).Event.range.maxDist))
-                                    ProcessEvent(*i);
-                        break;
+                            break;
+                        case EVENT_T_TIMER:
+                        case EVENT_T_MANA:
+                        case EVENT_T_HP:
+                        case EVENT_T_TARGET_HP:
+                        case EVENT_T_TARGET_CASTING:
+                        case EVENT_T_FRIENDLY_HP:
+                            if (me->getVictim())
+                                ProcessEvent(*i);
+                            break;
+                        case EVENT_T_RANGE:
+                            if (me->getVictim())
+                                if (me->IsInMap(me->getVictim()))
+                                    if (me->IsInRange(me->getVictim(), (float)(*i).Event.range.minDist, (float)(*i).Event.range.maxDist))
+                                        ProcessEvent(*i);
+                            break;
+                    }
                 }
             }
 
@@ -625,6 +625,8 @@ class CreatureEventAI : public CreatureAI
         uint32 m_EventUpdateTime;                           // Time between event updates
         uint32 m_EventDiff;                                 // Time between the last event call
         bool m_bEmptyList;
+        bool m_bHasTimerOOCEvents;                          // Out of combat timer events need every event update
+        bool m_bEventTimersPending;                         // Some event may have a running timer, event update can't be skipped out of combat
 
         typedef std::vector<CreatureEventAIHolder> CreatureEventAIList;
         CreatureEventAIList m_CreatureEventAIList;          // Holder for events (stores enabled, time, and eventid)
@@ -97,6 +97,10 @@ SmartScript::SmartScript()
     meOrigGUID = 0;
     goOrigGUID = 0;
     mLastInvoker = 0;
+    mSleeping = false;
+    mSleepInCombat = false;
+    mSleepTimer = 0;
+    mSleepDiff = 0;
 }
 
 SmartScript::~SmartScript()
@@ -109,6 +113,7 @@ SmartScript::~SmartScript()
 
 void SmartScript::OnReset()
 {
+    WakeUp();
     SetPhase(0);
     ResetBaseObject();
     for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
@@ -125,6 +130,8 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
+    WakeUp();
+
     for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
     {
         SMART_EVENT eventType = SMART_EVENT((*i).GetEventType());
@@ -2854,16 +2861,7 @@ void SmartScript::RecalcTimer(SmartScriptHolder& e, uint32 min, uint32 max)
 
 void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
 {
-    if (e.GetEventType() == SMART_EVENT_LINK)
-        return;
-
-    if (e.event.event_phase_mask && !IsInPhase(e.event.event_phase_mask))
-        return;
-
-    if (e.GetEventType() == SMART_EVENT_UPDATE_IC && (!me || !me->isInCombat()))
-        return;
-
-    if (e.GetEventType() == SMART_EVENT_UPDATE_OOC && (me && me->isInCombat()))//can be used with me=NULL (go script)
+    if (!IsEventTimerUpdatable(e, me && me->isInCombat()))
         return;
 
     if (e.timer < diff)
@@ -2882,39 +2880,21 @@ void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
         }
 
         e.active = true;//activate events with cooldown
-        switch (e.GetEventType())//process ONLY timed events
-        {
-            case SMART_EVENT_UPDATE:
-            case SMART_EVENT_UPDATE_OOC:
-            case SMART_EVENT_UPDATE_IC:
-            case SMART_EVENT_HEALT_PCT:
-            case SMART_EVENT_TARGET_HEALTH_PCT:
-            case SMART_EVENT_MANA_PCT:
-            case SMART_EVENT_TARGET_MANA_PCT:
-            case SMART_EVENT_RANGE:
-            case SMART_EVENT_TARGET_CASTING:
-            case SMART_EVENT_FRIENDLY_HEALTH:
-            case SMART_EVENT_FRIENDLY_IS_CC:
-            case SMART_EVENT_FRIENDLY_MISSING_BUFF:
-            case SMART_EVENT_HAS_AURA:
-            case SMART_EVENT_TARGET_BUFFED:
-            case SMART_EVENT_IS_BEHIND_TARGET:
-            {
-                ProcessEvent(e);
-                if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
+        if (IsTimedEvent(e.GetEventType()))//process ONLY timed events
+        {
+            ProcessEvent(e);
+            if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
+            {
+                e.enableTimed = false;//disable event if it is in an ActionList and was processed once
+                for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
                 {
-                    e.enableTimed = false;//disable event if it is in an ActionList and was processed once
-                    for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
+                    //find the first event which is not the current one and enable it
+                    if (i->event_id > e.event_id)
                     {
-                        //find the first event which is not the current one and enable it
-                        if (i->event_id > e.event_id)
-                        {
-                            i->enableTimed = true;
-                            break;
-                        }
+                        i->enableTimed = true;
+                        break;
                     }
                 }
-                break;
             }
         }
     }
@@ -2922,6 +2902,96 @@ void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
         e.timer -= diff;
 }
 
+bool SmartScript::IsTimedEvent(uint32 eventType)
+{
+    switch (eventType)
+    {
+        case SMART_EVENT_UPDATE:
+        case SMART_EVENT_UPDATE_OOC:
+        case SMART_EVENT_UPDATE_IC:
+        case SMART_EVENT_HEALT_PCT:
+        case SMART_EVENT_TARGET_HEALTH_PCT:
+        case SMART_EVENT_MANA_PCT:
+        case SMART_EVENT_TARGET_MANA_PCT:
+        case SMART_EVENT_RANGE:
+        case SMART_EVENT_TARGET_CASTING:
+        case SMART_EVENT_FRIENDLY_HEALTH:
+        case SMART_EVENT_FRIENDLY_IS_CC:
+        case SMART_EVENT_FRIENDLY_MISSING_BUFF:
+        case SMART_EVENT_HAS_AURA:
+        case SMART_EVENT_TARGET_BUFFED:
+        case SMART_EVENT_IS_BEHIND_TARGET:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool SmartScript::IsEventTimerUpdatable(SmartScriptHolder const& e, bool inCombat) const
+{
+    if (e.GetEventType() == SMART_EVENT_LINK)
+        return false;
+
+    if (e.event.event_phase_mask && !IsInPhase(e.event.event_phase_mask))
+        return false;
+
+    if (e.GetEventType() == SMART_EVENT_UPDATE_IC && !inCombat)
+        return false;
+
+    if (e.GetEventType() == SMART_EVENT_UPDATE_OOC && inCombat)//can be used with me=NULL (go script)
+        return false;
+
+    return true;
+}
+
+void SmartScript::UpdateSleepTimer()
+{
+    mSleeping = false;
+    mSleepDiff = 0;
+
+    // these lists and the text timer are updated with every diff
+    if (!mInstallEvents.empty() || !mStoredEvents.empty() || !mTimedActionList.empty() || !mRemIDs.empty() || mUseTextTimer)
+        return;
+
+    bool inCombat = me && me->isInCombat();
+    uint32 sleepTimer = std::numeric_limits<uint32>::max();
+    for (SmartAIEventList::const_iterator i = mEvents.begin(); i != mEvents.end(); ++i)
+    {
+        if (!IsEventTimerUpdatable(*i, inCombat))
+            continue;
+
+        // expiring again would not change anything for already active untimed events
+        if (i->active && !IsTimedEvent(i->GetEventType()))
+            continue;
+
+        sleepTimer = std::min(sleepTimer, i->timer);
+    }
+
+    if (!sleepTimer)
+        return;
+
+    mSleeping = true;
+    mSleepInCombat = inCombat;
+    mSleepTimer = sleepTimer;
+}
+
+void SmartScript::WakeUp()
+{
+    if (!mSleeping)
+        return;
+
+    mSleeping = false;
+    if (!mSleepDiff)
+        return;
+
+    // no timer counted for the sleep could expire, so this is what the skipped updates would have done
+    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
+        if (IsEventTimerUpdatable(*i, mSleepInCombat) && i->timer >= mSleepDiff)
+            i->timer -= mSleepDiff;
+
+    mSleepDiff = 0;
+}
+
 bool SmartScript::CheckTimer(SmartScriptHolder const& e) const
 {
     return e.active;
@@ -2956,10 +3026,30 @@ void SmartScript::OnUpdate(uint32 const diff)
     if ((mScriptType == SMART_SCRIPT_TYPE_CREATURE || mScriptType == SMART_SCRIPT_TYPE_GAMEOBJECT) && !GetBaseObject())
         return;
 
+    uint32 eventDiff = diff;
+    if (mSleeping)
+    {
+        if (mSleepInCombat == (me && me->isInCombat()))
+        {
+            // still no event timer can expire
+            if (diff <= mSleepTimer - mSleepDiff)
+            {
+                mSleepDiff += diff;
+                return;
+            }
+
+            eventDiff += mSleepDiff;
+            mSleeping = false;
+            mSleepDiff = 0;
+        }
+        else
+            WakeUp();
+    }
+
     InstallEvents();//before UpdateTimers
 
     for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-        UpdateTimer(*i, diff);
+        UpdateTimer(*i, eventDiff);
 
     if (!mStoredEvents.empty())
         for (SmartAIEventList::iterator i = mStoredEvents.begin(); i != mStoredEvents.end(); ++i)
@@ -3000,6 +3090,8 @@ void SmartScript::OnUpdate(uint32 const diff)
             ProcessEventsFor(SMART_EVENT_TEXT_OVER, NULL, textID, entry);
         } else mTextTimer -= diff;
     }
+
+    UpdateSleepTimer();
 }
 
 void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEntry const* at)
@@ -3094,6 +3186,12 @@ void SmartScript::OnInitialize(WorldObject* obj, AreaTriggerEntry const* at)
         return;
     }
 
+    // the timers are calculated again below, time counted during an earlier sleep no longer applies
+    mSleeping = false;
+    mSleepInCombat = false;
+    mSleepTimer = 0;
+    mSleepDiff = 0;
+
     GetScript();//load copy of script
 
     for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
@@ -3216,6 +3314,7 @@ void SmartScript::DoFindFriendlyMissingBuff(std::list<Creature*>& list, float ra
 
 void SmartScript::SetScript9(SmartScriptHolder& e, uint32 entry)
 {
+    WakeUp();
     mTimedActionList.clear();
     mTimedActionList = sSmartScriptMgr->GetScript(entry, SMART_SCRIPT_TYPE_TIMED_ACTIONLIST);
     if (mTimedActionList.empty())
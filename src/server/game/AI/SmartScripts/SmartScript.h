@@ -46,6 +46,7 @@ class SmartScript
         void RecalcTimer(SmartScriptHolder& e, uint32 min, uint32 max);
         void UpdateTimer(SmartScriptHolder& e, uint32 const diff);
         void InitTimer(SmartScriptHolder& e);
+        static bool IsTimedEvent(uint32 eventType);
         void ProcessAction(SmartScriptHolder& e, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
         ObjectList* GetTargets(SmartScriptHolder const& e, Unit* invoker = NULL);
         ObjectList* GetWorldObjectsInDist(float dist);
@@ -245,6 +246,17 @@ class SmartScript
         SMARTAI_TEMPLATE mTemplate;
         void InstallEvents();
 
+        // While no event timer can expire OnUpdate only accumulates the elapsed time,
+        // it is applied to the timers on the next full update or before any event is processed
+        bool IsEventTimerUpdatable(SmartScriptHolder const& e, bool inCombat) const;
+        void UpdateSleepTimer();
+        void WakeUp();
+
+        bool mSleeping;
+        bool mSleepInCombat;                                // combat state the sleep was computed for
+        uint32 mSleepTimer;                                 // time until the first event timer expires
+        uint32 mSleepDiff;                                  // time elapsed while sleeping
+
         void RemoveStoredEvent (uint32 id)
         {
             if (!mStoredEvents.empty())
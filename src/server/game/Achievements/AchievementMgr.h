@@ -57,7 +57,7 @@ class AchievementMgr : public AchievementMgrBase
 class AchievementGlobalMgr
 {
         friend class ACE_Singleton<AchievementGlobalMgr, ACE_Null_Mutex>;
-        AchievementGlobalMgr() {}
+        AchievementGlobalMgr();
         ~AchievementGlobalMgr() {}
 
     public:
@@ -66,6 +66,19 @@ class AchievementGlobalMgr
             return m_AchievementCriteriasByType[type];
         }
 
+        // criteria of the type an update with this miscValue1 can match, all criteria of the type if it isn't indexed
+        AchievementCriteriaEntryList const& GetAchievementCriteriaByMiscValue(AchievementCriteriaTypes type, uint32 miscValue1) const;
+        static bool IsCriteriaTypeIndexedByMiscValue(AchievementCriteriaTypes type);
+
+        // statistics only, updates from map threads are not synchronized
+        void AddCriteriaUpdateStats(AchievementCriteriaTypes type, uint32 visitedCriteria)
+        {
+            ++m_criteriaUpdateCalls[type];
+            m_criteriaUpdateVisits[type] += visitedCriteria;
+        }
+        uint64 GetCriteriaUpdateCalls(AchievementCriteriaTypes type) const { return m_criteriaUpdateCalls[type]; }
+        uint64 GetCriteriaUpdateVisits(AchievementCriteriaTypes type) const { return m_criteriaUpdateVisits[type]; }
+
         AchievementCriteriaEntryList const& GetTimedAchievementCriteriaByType(AchievementCriteriaTimedTypes type) const
         {
             return m_AchievementCriteriasByTimedType[type];
@@ -122,7 +135,13 @@ class AchievementGlobalMgr
 
         // store achievement criteria by type to speed up lookup
         AchievementCriteriaEntryList m_AchievementCriteriasByType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        // store criteria of the types that only match updates for their main requirement (creature, item, spell...) by that value
+        AchievementCriteriaListByMiscValue m_AchievementCriteriasByMiscValue[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        AchievementCriteriaEntryList m_emptyCriteriaList;
         AchievementCriteriaEntryList m_AchievementCriteriasByTimedType[ACHIEVEMENT_TIMED_TYPE_MAX];
+
+        uint64 m_criteriaUpdateCalls[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        uint64 m_criteriaUpdateVisits[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
         // store achievement criteria by achievement to speed up lookup
         AchievementCriteriaListByAchievement m_AchievementCriteriaListByAchievement;
         // store achievements by referenced achievement id to speed up lookup
@@ -352,6 +352,97 @@ void AchievementMgrBase::SendDirectMessageToAll(WorldPacket* data)
             player->SendDirectMessage(data);
 }
 
+void AchievementMgrBase::SaveChangedToDB(SQLTransaction& trans, char const* achievementTable, char const* progressTable, char const* ownerColumn, uint32 ownerId)
+{
+    // every flag set since the last save collapses into one row, so each table gets at most one
+    // statement per save however many times a criteria was updated in between
+    if (!m_completedAchievements.empty())
+    {
+        bool need_execute = false;
+        std::ostringstream ssrep;
+        for (CompletedAchievementMap::iterator iter = m_completedAchievements.begin(); iter != m_completedAchievements.end(); ++iter)
+        {
+            if (!iter->second.changed)
+                continue;
+
+            /// first new/changed record prefix
+            if (!need_execute)
+            {
+                ssrep << "REPLACE INTO " << achievementTable << " (" << ownerColumn << ", achievement, date) VALUES ";
+                need_execute = true;
+            }
+            /// next new/changed record prefix
+            else
+                ssrep << ',';
+
+            // new/changed record data
+            ssrep << '(' << ownerId << ',' << iter->first << ',' << uint64(iter->second.date) << ')';
+
+            /// mark as saved in db
+            iter->second.changed = false;
+        }
+
+        if (need_execute)
+            trans->Append(ssrep.str().c_str());
+    }
+
+    if (!m_criteriaProgress.empty())
+    {
+        /// rows with real progress are upserted, reset ones (0 progress state) are deleted
+        bool need_execute_del = false;
+        bool need_execute_rep = false;
+        std::ostringstream ssdel;
+        std::ostringstream ssrep;
+        for (CriteriaProgressMap::iterator iter = m_criteriaProgress.begin(); iter != m_criteriaProgress.end(); ++iter)
+        {
+            if (!iter->second.changed)
+                continue;
+
+            if (iter->second.counter == 0)
+            {
+                /// first reset record prefix
+                if (!need_execute_del)
+                {
+                    ssdel << "DELETE FROM " << progressTable << " WHERE " << ownerColumn << " = " << ownerId << " AND criteria IN (";
+                    need_execute_del = true;
+                }
+                /// next reset record prefix
+                else
+                    ssdel << ',';
+
+                ssdel << iter->first;
+            }
+            else
+            {
+                /// first new/changed record prefix
+                if (!need_execute_rep)
+                {
+                    ssrep << "REPLACE INTO " << progressTable << " (" << ownerColumn << ", criteria, counter, date) VALUES ";
+                    need_execute_rep = true;
+                }
+                /// next new/changed record prefix
+                else
+                    ssrep << ',';
+
+                // new/changed record data
+                ssrep << '(' << ownerId << ',' << iter->first << ',' << iter->second.counter << ',' << uint64(iter->second.date) << ')';
+            }
+
+            /// mark as updated in db
+            iter->second.changed = false;
+        }
+
+        if (need_execute_del)                                // DELETE ... IN (.... _)_
+        {
+            ssdel << ')';
+            trans->Append(ssdel.str().c_str());
+        }
+
+        if (need_execute_rep)
+            trans->Append(ssrep.str().c_str());
+    }
+}
+
 static const uint32 achievIdByArenaSlot[MAX_ARENA_SLOT] = { 1057, 1107, 1108 };
 static const uint32 achievIdForDungeon[][4] =
 {
@@ -378,8 +469,9 @@ void AchievementMgrBase::UpdateAchievementCriteria(AchievementCriteriaTypes type
     if (player->isGameMaster())
         return;
 
-    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(type);
-    for (AchievementCriteriaEntryList::const_iterator i = achievementCriteriaList.begin(); i != achievementCriteriaList.end(); ++i)
+    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByMiscValue(type, miscValue1);
+    uint32 visitedCriteria = 0;
+    for (AchievementCriteriaEntryList::const_iterator i = achievementCriteriaList.begin(); i != achievementCriteriaList.end(); ++i, ++visitedCriteria)
     {
         AchievementCriteriaEntry const *achievementCriteria = (*i);
         AchievementEntry const *achievement = sAchievementStore.LookupEntry(achievementCriteria->referredAchievement);
@@ -1233,6 +1325,8 @@ void AchievementMgrBase::UpdateAchievementCriteria(AchievementCriteriaTypes type
                 if (IsCompletedAchievement(*itr, player))
                     CompletedAchievement(*itr);
     }
+
+    sAchievementMgr->AddCriteriaUpdateStats(type, visitedCriteria);
 }
 
 static const uint32 achievIdByClass[MAX_CLASSES] = { 0, 459, 465, 462, 458, 464, 461, 467, 460, 463, 0, 466 };
@@ -32,6 +32,7 @@ typedef std::list<AchievementCriteriaEntry const*> AchievementCriteriaEntryList;
 typedef std::list<AchievementEntry const*>         AchievementEntryList;
 
 typedef std::map<uint32, AchievementCriteriaEntryList> AchievementCriteriaListByAchievement;
+typedef UNORDERED_MAP<uint32, AchievementCriteriaEntryList> AchievementCriteriaListByMiscValue;
 typedef std::map<uint32, AchievementEntryList>         AchievementListByReferencedId;
 
 struct CriteriaProgress
@@ -234,6 +235,8 @@ class AchievementMgrBase
         void CompletedCriteriaFor(AchievementEntry const* achievement, Player* player);
         virtual void CompletedAchievement(AchievementEntry const* entry) { }
         virtual void CompletedAchievement(AchievementEntry const* entry, Player* player) { }
+        // flushes changed achievements and criteria of one owner as multi-row REPLACE statements
+        void SaveChangedToDB(SQLTransaction& trans, char const* achievementTable, char const* progressTable, char const* ownerColumn, uint32 ownerId);
 
         uint32 m_achievementPoints;
         CriteriaProgressMap m_criteriaProgress;
@@ -40,7 +40,7 @@
 #include "Map.h"
 #include "InstanceScript.h"
 
-GuildAchievementMgr::GuildAchievementMgr(Guild* guild) : AchievementMgrBase(NULL, guild)
+GuildAchievementMgr::GuildAchievementMgr(Guild* guild) : AchievementMgrBase(NULL, guild), m_lastSave(0)
 {
 }
 
@@ -80,108 +80,14 @@ void GuildAchievementMgr::DeleteFromDB(uint32 id)
     CharacterDatabase.CommitTransaction(trans);
 }
 
-void GuildAchievementMgr::SaveToDB(SQLTransaction& trans)
+void GuildAchievementMgr::SaveToDB(SQLTransaction& trans, bool force)
 {
-    if (!m_completedAchievements.empty())
-    {
-        bool need_execute = false;
-        std::ostringstream ssdel;
-        std::ostringstream ssins;
-        for (CompletedAchievementMap::iterator iter = m_completedAchievements.begin(); iter != m_completedAchievements.end(); ++iter)
-        {
-            if (!iter->second.changed)
-                continue;
-
-            /// first new/changed record prefix
-            if (!need_execute)
-            {
-                ssdel << "DELETE FROM guild_achievement WHERE guildid = " << _guild->GetId() << " AND achievement IN (";
-                ssins << "INSERT INTO guild_achievement (guildid, achievement, date) VALUES ";
-                need_execute = true;
-            }
-            /// next new/changed record prefix
-            else
-            {
-                ssdel << ',';
-                ssins << ',';
-            }
-
-            // new/changed record data
-            ssdel << iter->first;
-            ssins << '(' << _guild->GetId() << ',' << iter->first << ',' << uint64(iter->second.date) << ')';
-
-            /// mark as saved in db
-            iter->second.changed = false;
-        }
-
-        if (need_execute)
-        {
-            ssdel << ')';
-            trans->Append(ssdel.str().c_str());
-            trans->Append(ssins.str().c_str());
-        }
-    }
-
-    if (!m_criteriaProgress.empty())
-    {
-        /// prepare deleting and insert
-        bool need_execute_del = false;
-        bool need_execute_ins = false;
-        std::ostringstream ssdel;
-        std::ostringstream ssins;
-        for (CriteriaProgressMap::iterator iter = m_criteriaProgress.begin(); iter != m_criteriaProgress.end(); ++iter)
-        {
-            if (!iter->second.changed)
-                continue;
-
-            // deleted data (including 0 progress state)
-            {
-                /// first new/changed record prefix (for any counter value)
-                if (!need_execute_del)
-                {
-                    ssdel << "DELETE FROM guild_achievement_progress WHERE guildid = " << _guild->GetId() << " AND criteria IN (";
-                    need_execute_del = true;
-                }
-                /// next new/changed record prefix
-                else
-                    ssdel << ',';
-
-                // new/changed record data
-                ssdel << iter->first;
-            }
-
-            // store data only for real progress
-            if (iter->second.counter != 0)
-            {
-                /// first new/changed record prefix
-                if (!need_execute_ins)
-                {
-                    ssins << "INSERT INTO guild_achievement_progress (guildid, criteria, counter, date) VALUES ";
-                    need_execute_ins = true;
-                }
-                /// next new/changed record prefix
-                else
-                    ssins << ',';
-
-                // new/changed record data
-                ssins << '(' << _guild->GetId() << ',' << iter->first << ',' << iter->second.counter << ',' << iter->second.date << ')';
-            }
-
-            /// mark as updated in db
-            iter->second.changed = false;
-        }
-
-        if (need_execute_del)                                // DELETE ... IN (.... _)_
-            ssdel << ')';
+    // changes made in between stay flagged and are coalesced into the next write
+    if (!force && m_lastSave && getMSTimeDiff(m_lastSave, getMSTime()) < GUILD_ACHIEVEMENT_SAVE_DELAY)
+        return;
 
-        if (need_execute_del || need_execute_ins)
-        {
-            if (need_execute_del)
-                trans->Append(ssdel.str().c_str());
-            if (need_execute_ins)
-                trans->Append(ssins.str().c_str());
-        }
-    }
+    m_lastSave = getMSTime();
+    SaveChangedToDB(trans, "guild_achievement", "guild_achievement_progress", "guildid", _guild->GetId());
 }
 
 void GuildAchievementMgr::LoadFromDB()
@@ -33,6 +33,8 @@ class Player;
 class Unit;
 class Guild;
 
+#define GUILD_ACHIEVEMENT_SAVE_DELAY (2 * MINUTE * IN_MILLISECONDS)
+
 class GuildAchievementMgr : public AchievementMgrBase
 {
     public:
@@ -43,7 +45,8 @@ class GuildAchievementMgr : public AchievementMgrBase
         void CheckAllAchievementCriteria();
         static void DeleteFromDB(uint32 guid_low);
         void LoadFromDB();
-        void SaveToDB(SQLTransaction& trans);
+        // the guild is saved by every member save, so writes are skipped unless forced or GUILD_ACHIEVEMENT_SAVE_DELAY passed
+        void SaveToDB(SQLTransaction& trans, bool force = false);
         Guild* GetGuild() { return _guild; }
         void ResetAchievementCriteria(AchievementCriteriaTypes type, uint32 miscvalue1 = 0, uint32 miscvalue2 = 0, bool evenIfCriteriaComplete = false);
         void CompletedAchievement(AchievementEntry const* entry, Player* player);
@@ -51,6 +54,8 @@ class GuildAchievementMgr : public AchievementMgrBase
 
     private:
         void SendAchievementEarned(AchievementEntry const* achievement);
+
+        uint32 m_lastSave;                                  // getMSTime() of the last write
 };
 
 #endif
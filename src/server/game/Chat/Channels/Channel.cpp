@@ -750,28 +750,23 @@ void Channel::SetOwner(uint64 guid, bool exclaim)
 
 void Channel::SendToAll(WorldPacket *data, uint64 p)
 {
+    std::vector<uint64> guids;
+    guids.reserve(players.size());
     for (PlayerList::const_iterator i = players.begin(); i != players.end(); ++i)
-    {
-        Player *player = ObjectAccessor::FindPlayer(i->first);
-        if (player)
-        {
-            if (!p || !player->GetSocial()->HasIgnore(GUID_LOPART(p)))
-                player->GetSession()->SendPacket(data);
-        }
-    }
+        guids.push_back(i->first);
+
+    WorldSession::BroadcastPacket(data, guids, p);
 }
 
 void Channel::SendToAllButOne(WorldPacket *data, uint64 who)
 {
+    std::vector<uint64> guids;
+    guids.reserve(players.size());
     for (PlayerList::const_iterator i = players.begin(); i != players.end(); ++i)
-    {
         if (i->first != who)
-        {
-            Player *player = ObjectAccessor::FindPlayer(i->first);
-            if (player)
-                player->GetSession()->SendPacket(data);
-        }
-    }
+            guids.push_back(i->first);
+
+    WorldSession::BroadcastPacket(data, guids);
 }
 
 void Channel::SendToOne(WorldPacket *data, uint64 who)
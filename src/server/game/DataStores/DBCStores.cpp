@@ -235,6 +235,7 @@ DBCStorage <WorldSafeLocsEntry> sWorldSafeLocsStore(WorldSafeLocsEntryfmt);
 typedef std::list<std::string> StoreProblemList;
 
 uint32 DBCFileCount = 0;
+static bool DBCMemoryMap = false;
 
 static bool LoadDBC_assert_print(uint32 fsize, uint32 rsize, const std::string& filename)
 {
@@ -256,7 +257,7 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
     if (customFormat)
         sql = new SqlDbc(&filename, customFormat, customIndexName, storage.GetFormat());
 
-    if (storage.Load(dbcFilename.c_str(), sql))
+    if (storage.Load(dbcFilename.c_str(), sql, DBCMemoryMap))
     {
         for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
         {
@@ -268,7 +269,7 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
             localizedName.push_back('/');
             localizedName.append(filename);
 
-            if (!storage.LoadStringsFrom(localizedName.c_str()))
+            if (!storage.LoadStringsFrom(localizedName.c_str(), DBCMemoryMap))
                 availableDbcLocales &= ~(1<<i);             // mark as not available for speedup next checks
         }
     }
@@ -289,10 +290,12 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
     delete sql;
 }
 
-void LoadDBCStores(const std::string& dataPath, uint32& availableDbcLocales)
+void LoadDBCStores(const std::string& dataPath, uint32& availableDbcLocales, bool memoryMap)
 {
     uint32 oldMSTime = getMSTime();
 
+    DBCMemoryMap = memoryMap;
+
     std::string dbcPath = dataPath + "dbc/";
 
     StoreProblemList bad_dbc_files;
@@ -212,6 +212,6 @@ extern DBCStorage <WorldMapOverlayEntry>         sWorldMapOverlayStore;
 extern DBCStorage <WorldSafeLocsEntry>           sWorldSafeLocsStore;
 //extern DBCStorage <WorldStateEntry>              sWorldStateStore;
 
-void LoadDBCStores(const std::string& dataPath, uint32& availableDbcLocales);
+void LoadDBCStores(const std::string& dataPath, uint32& availableDbcLocales, bool memoryMap);
 
 #endif
@@ -785,7 +785,8 @@ void LFGMgr::OfferContinue(Group* group)
 */
 LfgProposal* LFGMgr::FindNewGroups(LfgGuidList& check, LfgGuidList& all)
 {
-    sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::FindNewGroup: (%s) - all(%s)", ConcatenateGuids(check).c_str(), ConcatenateGuids(all).c_str());
+    if (sLog->IsOutDebug())
+        sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::FindNewGroup: (%s) - all(%s)", ConcatenateGuids(check).c_str(), ConcatenateGuids(all).c_str());
 
     LfgProposal* pProposal = NULL;
     if (!check.size() || check.size() > MAXGROUPSIZE || !CheckCompatibility(check, pProposal))
@@ -805,16 +806,19 @@ LfgProposal* LFGMgr::FindNewGroups(LfgGuidList& check, LfgGuidList& all)
 /**
    Check compatibilities between groups
 
-   @param[in]     check List of guids to check compatibilities
+   @param[in]     check List of guids to check compatibilities (restored before returning)
    @param[out]    pProposal Proposal found if groups are compatibles and Match
    @return true if group are compatibles
 */
-bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
+bool LFGMgr::CheckCompatibility(LfgGuidList& check, LfgProposal*& pProposal)
 {
     if (pProposal)                                         // Do not check anything if we already have a proposal
         return false;
 
-    std::string strGuids = ConcatenateGuids(check);
+    // Only used for debug output, do not build it when nobody will read it
+    std::string strGuids;
+    if (sLog->IsOutDebug())
+        strGuids = ConcatenateGuids(check);
 
     if (check.size() > MAXGROUPSIZE || !check.size())
     {
@@ -826,7 +830,8 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
         return true;
 
     // Previously cached?
-    LfgAnswer answer = GetCompatibles(strGuids);
+    LfgCompatibleKey key(check);
+    LfgAnswer answer = GetCompatibles(key);
     if (answer != LFG_ANSWER_PENDING)
     {
         sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) compatibles (cached): %d", strGuids.c_str(), answer);
@@ -840,13 +845,14 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
         check.pop_front();
 
         // Check all-but-new compatibilities (New, A, B, C, D) --> check(A, B, C, D)
-        if (!CheckCompatibility(check, pProposal))          // Group not compatible
+        bool compatibles = CheckCompatibility(check, pProposal);
+        check.push_front(frontGuid);
+        if (!compatibles)                                   // Group not compatible
         {
-            sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) not compatibles (%s not compatibles)", strGuids.c_str(), ConcatenateGuids(check).c_str());
-            SetCompatibles(strGuids, false);
+            sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) not compatibles (all but [" UI64FMTD "] not compatibles)", strGuids.c_str(), frontGuid);
+            SetCompatibles(key, false);
             return false;
         }
-        check.push_front(frontGuid);
         // all-but-new compatibles, now check with new
     }
 
@@ -886,7 +892,7 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
     // Do not match - groups already in a lfgDungeon or too much players
     if (numLfgGroups > 1 || numPlayers > MAXGROUPSIZE)
     {
-        SetCompatibles(strGuids, false);
+        SetCompatibles(key, false);
         if (numLfgGroups > 1)
             sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) More than one Lfggroup (%u)", strGuids.c_str(), numLfgGroups);
         else
@@ -940,7 +946,7 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
     {
         if (players.size() == numPlayers)
             sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) Roles not compatible", strGuids.c_str());
-        SetCompatibles(strGuids, false);
+        SetCompatibles(key, false);
         return false;
     }
 
@@ -964,10 +970,10 @@ bool LFGMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
 
     if (compatibleDungeons.empty())
     {
-        SetCompatibles(strGuids, false);
+        SetCompatibles(key, false);
         return false;
     }
-    SetCompatibles(strGuids, true);
+    SetCompatibles(key, true);
 
     // ----- Group is compatible, if we have MAXGROUPSIZE members then match is found
     if (numPlayers != MAXGROUPSIZE)
@@ -1185,6 +1191,28 @@ void LFGMgr::UpdateRoleCheck(uint64& gguid, uint64 guid /* = 0 */, uint8 roles /
     }
 }
 
+/**
+   Builds the compatible cache key of a list of guids. Guids are stored sorted
+   so the same groups checked in different order share the cached answer
+
+   @param[in]     check List of guids (at most LFG_MAX_CHECK_GUIDS)
+*/
+LfgCompatibleKey::LfgCompatibleKey(const LfgGuidList& check): count(0)
+{
+    for (LfgGuidList::const_iterator it = check.begin(); it != check.end() && count < LFG_MAX_CHECK_GUIDS; ++it)
+        guids[count++] = *it;
+
+    std::sort(guids, guids + count);
+}
+
+bool LfgCompatibleKey::operator<(const LfgCompatibleKey& other) const
+{
+    if (count != other.count)
+        return count < other.count;
+
+    return std::lexicographical_compare(guids, guids + count, other.guids, other.guids + other.count);
+}
+
 /**
    Remove from cached compatible dungeons any entry that contains the given guid
 
@@ -1192,37 +1220,61 @@ void LFGMgr::UpdateRoleCheck(uint64& gguid, uint64 guid /* = 0 */, uint8 roles /
 */
 void LFGMgr::RemoveFromCompatibles(uint64 guid)
 {
-    std::stringstream out;
-    out << guid;
-    std::string strGuid = out.str();
-
     sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::RemoveFromCompatibles: Removing [" UI64FMTD "]", guid);
-    for (LfgCompatibleMap::iterator itNext = m_CompatibleMap.begin(); itNext != m_CompatibleMap.end();)
+    LfgCompatibleIndex::iterator itIndex = m_CompatibleIndex.find(guid);
+    if (itIndex == m_CompatibleIndex.end())
+        return;
+
+    // Take the keys out so erasing them from the other guids of each key can't invalidate the loop
+    LfgCompatibleKeySet keys;
+    keys.swap(itIndex->second);
+    m_CompatibleIndex.erase(itIndex);
+
+    for (LfgCompatibleKeySet::const_iterator it = keys.begin(); it != keys.end(); ++it)
     {
-        LfgCompatibleMap::iterator it = itNext++;
-        if (it->first.find(strGuid) != std::string::npos)  // Found, remove it
-            m_CompatibleMap.erase(it);
+        m_CompatibleMap.erase(*it);
+        for (uint8 i = 0; i < it->count; ++i)
+        {
+            if (it->guids[i] == guid)
+                continue;
+
+            LfgCompatibleIndex::iterator itOther = m_CompatibleIndex.find(it->guids[i]);
+            if (itOther == m_CompatibleIndex.end())
+                continue;
+
+            itOther->second.erase(*it);
+            if (itOther->second.empty())
+                m_CompatibleIndex.erase(itOther);
+        }
     }
 }
 
 /**
    Stores the compatibility of a list of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Sorted guids of the list
    @param[in]     compatibles Compatibles or not
 */
-void LFGMgr::SetCompatibles(std::string key, bool compatibles)
+void LFGMgr::SetCompatibles(const LfgCompatibleKey& key, bool compatibles)
 {
-    m_CompatibleMap[key] = LfgAnswer(compatibles);
+    std::pair<LfgCompatibleMap::iterator, bool> result = m_CompatibleMap.insert(LfgCompatibleMap::value_type(key, LfgAnswer(compatibles)));
+    if (!result.second)
+    {
+        result.first->second = LfgAnswer(compatibles);
+        return;
+    }
+
+    for (uint8 i = 0; i < key.count; ++i)
+        m_CompatibleIndex[key.guids[i]].insert(key);
 }
 
 /**
    Get the compatibility of a group of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Sorted guids of the list
    @return 1 (Compatibles), 0 (Not compatibles), -1 (Not set)
 */
-LfgAnswer LFGMgr::GetCompatibles(std::string key)
+LfgAnswer LFGMgr::GetCompatibles(const LfgCompatibleKey& key)
 {
     LfgAnswer answer = LFG_ANSWER_PENDING;
     LfgCompatibleMap::iterator it = m_CompatibleMap.find(key);
@@ -1245,7 +1297,7 @@ void LFGMgr::GetCompatibleDungeons(LfgDungeonSet& dungeons, const PlayerSet& pla
     for (PlayerSet::const_iterator it = players.begin(); it != players.end() && dungeons.size(); ++it)
     {
         uint64 guid = (*it)->GetGUID();
-        LfgLockMap cachedLockMap = GetLockedDungeons(guid);
+        const LfgLockMap& cachedLockMap = GetLockedDungeons(guid);
         for (LfgLockMap::const_iterator it2 = cachedLockMap.begin(); it2 != cachedLockMap.end() && dungeons.size(); ++it2)
         {
             uint32 dungeonId = (it2->first & 0x00FFFFFF); // Compare dungeon ids
@@ -1980,7 +2032,7 @@ LfgType LFGMgr::GetDungeonType(uint32 dungeonId)
    @param[in]     check list of guids
    @returns Concatenated string
 */
-std::string LFGMgr::ConcatenateGuids(LfgGuidList check)
+std::string LFGMgr::ConcatenateGuids(const LfgGuidList& check)
 {
     if (check.empty())
         return "";
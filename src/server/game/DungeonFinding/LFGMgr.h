@@ -37,6 +37,7 @@ enum LFGenum
     LFG_TANKS_NEEDED                             = 1,
     LFG_HEALERS_NEEDED                           = 1,
     LFG_DPS_NEEDED                               = 3,
+    LFG_MAX_CHECK_GUIDS                          = LFG_TANKS_NEEDED + LFG_HEALERS_NEEDED + LFG_DPS_NEEDED,
     LFG_QUEUEUPDATE_INTERVAL                     = 15*IN_MILLISECONDS,
     LFG_SPELL_DUNGEON_COOLDOWN                   = 71328,
     LFG_SPELL_DUNGEON_DESERTER                   = 71041,
@@ -133,7 +134,6 @@ typedef std::set<Player*> PlayerSet;
 typedef std::list<Player*> LfgPlayerList;
 typedef std::multimap<uint32, LfgReward const*> LfgRewardMap;
 typedef std::pair<LfgRewardMap::const_iterator, LfgRewardMap::const_iterator> LfgRewardMapBounds;
-typedef std::map<std::string, LfgAnswer> LfgCompatibleMap;
 typedef std::map<uint64, LfgDungeonSet> LfgDungeonMap;
 typedef std::map<uint64, uint8> LfgRolesMap;
 typedef std::map<uint64, LfgAnswer> LfgAnswerMap;
@@ -145,6 +145,20 @@ typedef std::map<uint32, LfgPlayerBoot*> LfgPlayerBootMap;
 typedef std::map<uint64, LfgGroupData> LfgGroupDataMap;
 typedef std::map<uint64, LfgPlayerData> LfgPlayerDataMap;
 
+/// Order independent key of a list of guids checked for compatibility
+struct LfgCompatibleKey
+{
+    explicit LfgCompatibleKey(const LfgGuidList& check);
+    bool operator<(const LfgCompatibleKey& other) const;
+
+    uint64 guids[LFG_MAX_CHECK_GUIDS];                     ///< Sorted guids
+    uint8 count;                                           ///< Number of used guids
+};
+
+typedef std::map<LfgCompatibleKey, LfgAnswer> LfgCompatibleMap;
+typedef std::set<LfgCompatibleKey> LfgCompatibleKeySet;
+typedef std::map<uint64, LfgCompatibleKeySet> LfgCompatibleIndex;
+
 // Data needed by SMSG_LFG_JOIN_RESULT
 struct LfgJoinResultData
 {
@@ -323,16 +337,16 @@ class LFGMgr
         // Group Matching
         LfgProposal* FindNewGroups(LfgGuidList& check, LfgGuidList& all);
         bool CheckGroupRoles(LfgRolesMap &groles, bool removeLeaderFlag = true);
-        bool CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal);
+        bool CheckCompatibility(LfgGuidList& check, LfgProposal*& pProposal);
         void GetCompatibleDungeons(LfgDungeonSet& dungeons, const PlayerSet& players, LfgLockPartyMap& lockMap);
-        void SetCompatibles(std::string concatenatedGuids, bool compatibles);
-        LfgAnswer GetCompatibles(std::string concatenatedGuids);
+        void SetCompatibles(const LfgCompatibleKey& key, bool compatibles);
+        LfgAnswer GetCompatibles(const LfgCompatibleKey& key);
         void RemoveFromCompatibles(uint64 guid);
 
         // Generic
         const LfgDungeonSet& GetDungeonsByRandom(uint32 randomdungeon);
         LfgType GetDungeonType(uint32 dungeon);
-        std::string ConcatenateGuids(LfgGuidList check);
+        std::string ConcatenateGuids(const LfgGuidList& check);
 
         // General variables
         bool m_update;                                     ///< Doing an update?
@@ -354,6 +368,7 @@ class LFGMgr
         LfgGuidListMap m_currentQueue;                     ///< Ordered list. Used to find groups
         LfgGuidListMap m_newToQueue;                       ///< New groups to add to queue
         LfgCompatibleMap m_CompatibleMap;                  ///< Compatible dungeons
+        LfgCompatibleIndex m_CompatibleIndex;              ///< Compatible cache keys each guid is part of
         LfgGuidList m_teleport;                            ///< Players being teleported
         // Rolecheck - Proposal - Vote Kicks
         LfgRoleCheckMap m_RoleChecks;                      ///< Current Role checks
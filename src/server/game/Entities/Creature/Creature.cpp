@@ -51,6 +51,7 @@
 #include "Group.h"
 #include "MoveSplineInit.h"
 #include "MoveSpline.h"
+#include "Profiler.h"
 // apply implementation of the singletons
 
 TrainerSpell const* TrainerSpellData::Find(uint32 spell_id) const
@@ -108,6 +109,19 @@ uint32 CreatureTemplate::GetFirstValidModelId() const
     return 0;
 }
 
+void CreatureTemplate::InitAIProfile()
+{
+    AIProfileId = ScriptID ? ScriptID : Profiler::HashName(GetAIProfileName());
+}
+
+char const* CreatureTemplate::GetAIProfileName() const
+{
+    if (ScriptID)
+        return sObjectMgr->GetScriptName(ScriptID);
+
+    return AIName.empty() ? "<default AI>" : AIName.c_str();
+}
+
 bool AssistDelayEvent::Execute(uint64 /*e_time*/, uint32 /*p_time*/)
 {
     if (Unit* victim = Unit::GetUnit(_owner, m_victim))
@@ -533,7 +547,11 @@ void Creature::Update(uint32 diff)
             {
                 // do not allow the AI to be changed during update
                 _AI_locked = true;
-                i_AI->UpdateAI(diff);
+                {
+                    CreatureTemplate const* cinfo = GetCreatureTemplate();
+                    ProfileScope profile(PROFILE_CREATURE_AI, cinfo->AIProfileId, cinfo->GetAIProfileName());
+                    i_AI->UpdateAI(diff);
+                }
                 _AI_locked = false;
             }
 
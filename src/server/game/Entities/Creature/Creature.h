@@ -146,9 +146,15 @@ struct CreatureTemplate
     uint32  MechanicImmuneMask;
     uint32  flags_extra;
     uint32  ScriptID;
+    uint32  AIProfileId;                                    // set by InitAIProfile
     uint32  GetRandomValidModelId() const;
     uint32  GetFirstValidModelId() const;
 
+    // Creature::Update accounts the AI time of scripted creatures by script, the others by AI name.
+    // InitAIProfile has to be called whenever AIName or ScriptID change.
+    void InitAIProfile();
+    char const* GetAIProfileName() const;
+
     // helpers
     SkillType GetRequiredLootSkill() const
     {
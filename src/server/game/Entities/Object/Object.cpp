@@ -315,7 +315,10 @@ void Object::_BuildMovementUpdate(ByteBuffer * data, uint16 flags) const
 
         // 0x08000000
         if (self->_movementInfo.HasMovementFlag(MOVEMENTFLAG_SPLINE_ENABLED))
+        {
+            self->UpdateSplineState();
             Movement::PacketBuilder::WriteCreate(*self->movespline, *data);
+        }
     }
     else
     {
@@ -2776,7 +2779,7 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
-    std::set<uint64> player_list;
+    std::set<uint64, std::less<uint64>, TickArenaAllocator<uint64> > player_list;
     WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj) {}
     void Visit(PlayerMapType &m)
     {
@@ -876,14 +876,14 @@ class WorldObject : public Object, public WorldLocation
 
 namespace SkyFire
 {
-    template<class T>
-    void RandomResizeList(std::list<T> &_list, uint32 _size)
+    template<class T, class A>
+    void RandomResizeList(std::list<T, A> &_list, uint32 _size)
     {
         size_t list_size = _list.size();
 
         while (list_size > _size)
         {
-            typename std::list<T>::iterator itr = _list.begin();
+            typename std::list<T, A>::iterator itr = _list.begin();
             std::advance(itr, urand(0, list_size - 1));
             _list.erase(itr);
             --list_size;
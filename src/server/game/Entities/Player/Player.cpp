@@ -788,6 +788,10 @@ Player::Player(WorldSession* session): Unit(true), _achievementMgr(this), _reput
     _mailsLoaded = false;
     _mailsUpdated = false;
     unReadMails = 0;
+
+    _savedAurasValid = false;
+    memset(_savedGlyphs, 0, sizeof(_savedGlyphs));
+    _savedGlyphSpecs = 0;
     _nextMailDelivereTime = 0;
 
     _itemUpdateQueueBlocked = false;
@@ -19782,8 +19786,9 @@ void Player::SaveToDB(bool create /*=false*/)
     _achievementMgr.SaveToDB(trans);
     _reputationMgr.SaveToDB(trans);
 
+    // guild progress is shared by all members, only write it through the first save in a while or when leaving the game
     if (Guild* guild = sGuildMgr->GetGuildById(GetGuildId()))
-        guild->GetAchievementMgr().SaveToDB(trans);
+        guild->GetAchievementMgr().SaveToDB(trans, GetSession()->PlayerLogout());
 
     _SaveEquipmentSets(trans);
     GetSession()->SaveTutorialsData(trans);                 // changed only while character in game
@@ -19797,6 +19802,10 @@ void Player::SaveToDB(bool create /*=false*/)
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
 
+    if (sLog->IsOutDebug())
+        sLog->outDebug(LOG_FILTER_UNITS, "Player::SaveToDB: %s (GUID: %u) saved with %u statements, %u bytes",
+            m_name.c_str(), GetGUIDLow(), uint32(trans->GetSize()), uint32(trans->GetDataSize()));
+
     CharacterDatabase.CommitTransaction(trans);
 
     // save pet (hunter pet level and experience and all type pets health/mana).
@@ -19847,10 +19856,18 @@ void Player::_SaveActions(SQLTransaction& trans)
 
 void Player::_SaveAuras(SQLTransaction& trans)
 {
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_AURA);
-    stmt->setUInt32(0, GetGUIDLow());
-    trans->Append(stmt);
+    PreparedStatement* stmt = NULL;
+
+    // The first save rewrites all rows, later ones only replace the auras that changed and delete the ones that are gone
+    if (!_savedAurasValid)
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_AURA);
+        stmt->setUInt32(0, GetGUIDLow());
+        trans->Append(stmt);
+        _savedAuras.clear();
+    }
 
+    SavedAuraMap auras;
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
         if (!itr->second->CanBeSaved())
@@ -19858,47 +19875,80 @@ void Player::_SaveAuras(SQLTransaction& trans)
 
         Aura* aura = itr->second;
 
-        int32 damage[MAX_SPELL_EFFECTS];
-        int32 baseDamage[MAX_SPELL_EFFECTS];
+        SavedAuraData data;
         uint8 effMask = 0;
-        uint8 recalculateMask = 0;
+        data.recalculateMask = 0;
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
             if (AuraEffect const* effect = aura->GetEffect(i))
             {
-                baseDamage[i] = effect->GetBaseAmount();
-                damage[i] = effect->GetAmount();
+                data.baseAmount[i] = effect->GetBaseAmount();
+                data.amount[i] = effect->GetAmount();
                 effMask |= 1 << i;
                 if (effect->CanBeRecalculated())
-                    recalculateMask |= 1 << i;
+                    data.recalculateMask |= 1 << i;
             }
             else
             {
-                baseDamage[i] = 0;
-                damage[i] = 0;
+                data.baseAmount[i] = 0;
+                data.amount[i] = 0;
             }
         }
 
+        data.stackAmount = aura->GetStackAmount();
+        data.maxDuration = aura->GetMaxDuration();
+        data.duration = aura->GetDuration();
+        data.charges = aura->GetCharges();
+
+        SavedAuraKey key;
+        key.casterGuid = aura->GetCasterGUID();
+        key.itemGuid = aura->GetCastItemGUID();
+        key.spellId = aura->GetId();
+        key.effectMask = effMask;
+
+        auras[key] = data;
+
+        SavedAuraMap::const_iterator saved = _savedAuras.find(key);
+        if (saved != _savedAuras.end() && saved->second == data)
+            continue;
+
         uint8 index = 0;
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_AURA);
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_AURA);
         stmt->setUInt32(index++, GetGUIDLow());
-        stmt->setUInt64(index++, itr->second->GetCasterGUID());
-        stmt->setUInt64(index++, itr->second->GetCastItemGUID());
-        stmt->setUInt32(index++, itr->second->GetId());
-        stmt->setUInt8(index++, effMask);
-        stmt->setUInt8(index++, recalculateMask);
-        stmt->setUInt8(index++, itr->second->GetStackAmount());
-        stmt->setInt32(index++, damage[0]);
-        stmt->setInt32(index++, damage[1]);
-        stmt->setInt32(index++, damage[2]);
-        stmt->setInt32(index++, baseDamage[0]);
-        stmt->setInt32(index++, baseDamage[1]);
-        stmt->setInt32(index++, baseDamage[2]);
-        stmt->setInt32(index++, itr->second->GetMaxDuration());
-        stmt->setInt32(index++, itr->second->GetDuration());
-        stmt->setUInt8(index, itr->second->GetCharges());
+        stmt->setUInt64(index++, key.casterGuid);
+        stmt->setUInt64(index++, key.itemGuid);
+        stmt->setUInt32(index++, key.spellId);
+        stmt->setUInt8(index++, key.effectMask);
+        stmt->setUInt8(index++, data.recalculateMask);
+        stmt->setUInt8(index++, data.stackAmount);
+        stmt->setInt32(index++, data.amount[0]);
+        stmt->setInt32(index++, data.amount[1]);
+        stmt->setInt32(index++, data.amount[2]);
+        stmt->setInt32(index++, data.baseAmount[0]);
+        stmt->setInt32(index++, data.baseAmount[1]);
+        stmt->setInt32(index++, data.baseAmount[2]);
+        stmt->setInt32(index++, data.maxDuration);
+        stmt->setInt32(index++, data.duration);
+        stmt->setUInt8(index, data.charges);
         trans->Append(stmt);
     }
+
+    for (SavedAuraMap::const_iterator itr = _savedAuras.begin(); itr != _savedAuras.end(); ++itr)
+    {
+        if (auras.find(itr->first) != auras.end())
+            continue;
+
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_AURA_ENTRY);
+        stmt->setUInt32(0, GetGUIDLow());
+        stmt->setUInt64(1, itr->first.casterGuid);
+        stmt->setUInt64(2, itr->first.itemGuid);
+        stmt->setUInt32(3, itr->first.spellId);
+        stmt->setUInt8(4, itr->first.effectMask);
+        trans->Append(stmt);
+    }
+
+    _savedAuras.swap(auras);
+    _savedAurasValid = true;
 }
 
 void Player::_SaveInventory(SQLTransaction& trans)
@@ -22410,20 +22460,20 @@ bool Player::IsVisibleGloballyFor(Player* u) const
 }
 
 template<class T>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, T* target, std::set<Unit*>& /*v*/)
+inline void UpdateVisibilityOf_helper(Player::ClientGUIDs& s64, T* target, std::set<Unit*>& /*v*/)
 {
     s64.insert(target->GetGUID());
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, Creature* target, std::set<Unit*>& v)
+inline void UpdateVisibilityOf_helper(Player::ClientGUIDs& s64, Creature* target, std::set<Unit*>& v)
 {
     s64.insert(target->GetGUID());
     v.insert(target);
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, Player* target, std::set<Unit*>& v)
+inline void UpdateVisibilityOf_helper(Player::ClientGUIDs& s64, Player* target, std::set<Unit*>& v)
 {
     s64.insert(target->GetGUID());
     v.insert(target);
@@ -25730,12 +25780,21 @@ void Player::_LoadGlyphs(PreparedQueryResult result)
 
 void Player::_SaveGlyphs(SQLTransaction& trans)
 {
-    trans->PAppend("DELETE FROM character_glyphs WHERE guid='%u'", GetGUIDLow());
+    // only specs whose glyphs changed since the last save are written, rows of removed specs are deleted
+    if (!_savedGlyphSpecs || _savedGlyphSpecs > GetSpecsCount())
+        trans->PAppend("DELETE FROM character_glyphs WHERE guid='%u' AND spec >= '%u'", GetGUIDLow(), GetSpecsCount());
+
     for (uint8 spec = 0; spec < GetSpecsCount(); ++spec)
     {
-        trans->PAppend("INSERT INTO character_glyphs VALUES('%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u')",
+        if (spec < _savedGlyphSpecs && !memcmp(_savedGlyphs[spec], _talentMgr->SpecInfo[spec].Glyphs, sizeof(_savedGlyphs[spec])))
+            continue;
+
+        trans->PAppend("REPLACE INTO character_glyphs VALUES('%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u')",
             GetGUIDLow(), spec, GetGlyph(spec, 0), GetGlyph(spec, 1), GetGlyph(spec, 2), GetGlyph(spec, 3), GetGlyph(spec, 4), GetGlyph(spec, 5), GetGlyph(spec, 6), GetGlyph(spec, 7), GetGlyph(spec, 8));
+        memcpy(_savedGlyphs[spec], _talentMgr->SpecInfo[spec].Glyphs, sizeof(_savedGlyphs[spec]));
     }
+
+    _savedGlyphSpecs = GetSpecsCount();
 }
 
 void Player::_LoadTalents(PreparedQueryResult result)
@@ -143,6 +143,50 @@ struct SpellCooldown
 };
 
 typedef std::map<uint32, SpellCooldown> SpellCooldowns;
+
+// Primary key of a character_aura row
+struct SavedAuraKey
+{
+    uint64 casterGuid;
+    uint64 itemGuid;
+    uint32 spellId;
+    uint8 effectMask;
+
+    bool operator<(SavedAuraKey const& right) const
+    {
+        if (spellId != right.spellId)
+            return spellId < right.spellId;
+        if (casterGuid != right.casterGuid)
+            return casterGuid < right.casterGuid;
+        if (itemGuid != right.itemGuid)
+            return itemGuid < right.itemGuid;
+        return effectMask < right.effectMask;
+    }
+};
+
+struct SavedAuraData
+{
+    uint8 recalculateMask;
+    uint8 stackAmount;
+    uint8 charges;
+    int32 amount[MAX_SPELL_EFFECTS];
+    int32 baseAmount[MAX_SPELL_EFFECTS];
+    int32 maxDuration;
+    int32 duration;
+
+    bool operator==(SavedAuraData const& right) const
+    {
+        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+            if (amount[i] != right.amount[i] || baseAmount[i] != right.baseAmount[i])
+                return false;
+
+        return recalculateMask == right.recalculateMask && stackAmount == right.stackAmount && charges == right.charges &&
+            maxDuration == right.maxDuration && duration == right.duration;
+    }
+};
+
+// character_aura rows as written by the last save
+typedef std::map<SavedAuraKey, SavedAuraData> SavedAuraMap;
 typedef UNORDERED_MAP<uint32 /*instanceId*/, time_t/*releaseTime*/> InstanceTimeMap;
 
 enum TrainerSpellState
@@ -2443,7 +2487,7 @@ class Player : public Unit, public GridObject<Player>
         PetSlot getSlotForNewPet();
 
         // currently visible objects at player client
-        typedef std::set<uint64> ClientGUIDs;
+        typedef UNORDERED_SET<uint64> ClientGUIDs;
         ClientGUIDs m_clientGUIDs;
 
         bool HaveAtClient(WorldObject const* u) const { return u == this || m_clientGUIDs.find(u->GetGUID()) != m_clientGUIDs.end(); }
@@ -2963,6 +3007,12 @@ class Player : public Unit, public GridObject<Player>
 
         SpellCooldowns _spellCooldowns;
 
+        // What the last save wrote, so later saves only write rows that changed
+        SavedAuraMap _savedAuras;
+        bool _savedAurasValid;                              // false until the first save rewrote all aura rows
+        uint32 _savedGlyphs[MAX_TALENT_SPECS][MAX_GLYPH_SLOT_INDEX];
+        uint8 _savedGlyphSpecs;                             // 0 until the first save wrote the glyph rows
+
         uint32 _ChampioningFaction;
         uint32 _ChampioningFactionDungeonLevel;
 
@@ -152,7 +152,7 @@ Unit::Unit(bool isWorldObject): WorldObject(isWorldObject),
 _movedPlayer(NULL), m_lastSanctuaryTime(0), IsAIEnabled(false), NeedChangeAI(false),
 _ControlledByPlayer(false), i_AI(NULL), i_disabledAI(NULL), m_procDeep(0),
 m_removedAurasCount(0), i_motionMaster(this), m_ThreatManager(this), m_vehicle(NULL),
-_vehicleKit(NULL), m_unitTypeMask(UNIT_MASK_NONE), m_HostileRefManager(this), movespline(new Movement::MoveSpline())
+_vehicleKit(NULL), m_unitTypeMask(UNIT_MASK_NONE), m_HostileRefManager(this), movespline(new Movement::MoveSpline()), m_movesplineDelay(0)
 {
 #ifdef _MSC_VER
 #pragma warning(default:4355)
@@ -191,6 +191,7 @@ _vehicleKit(NULL), m_unitTypeMask(UNIT_MASK_NONE), m_HostileRefManager(this), mo
     m_auraUpdateIterator = m_ownedAuras.end();
 
     m_interruptMask = 0;
+    m_procAuraFlagMask = 0;
     m_transform = 0;
     m_canModifyStats = false;
 
@@ -393,13 +394,19 @@ void Unit::UpdateSplineMovement(uint32 t_diff)
     if (movespline->Finalized())
         return;
 
-    movespline->updateState(t_diff);
+    // the spline only advances when the unit arrives or its position is refreshed,
+    // anything reading its progress in between calls UpdateSplineState first
+    m_movesplineDelay += t_diff;
+    m_movesplineTimer.Update(t_diff);
+    if (!m_movesplineTimer.Passed() && (movespline->isCyclic() || m_movesplineDelay < uint32(movespline->timeElapsed())))
+        return;
+
+    UpdateSplineState();
     bool arrived = movespline->Finalized();
 
     if (arrived)
         DisableSpline();
 
-    m_movesplineTimer.Update(t_diff);
     if (m_movesplineTimer.Passed() || arrived)
     {
         m_movesplineTimer.Reset(POSITION_UPDATE_DELAY);
@@ -417,6 +424,14 @@ void Unit::UpdateSplineMovement(uint32 t_diff)
     }
 }
 
+void Unit::UpdateSplineState() const
+{
+    if (m_movesplineDelay && !movespline->Finalized())
+        movespline->updateState(m_movesplineDelay);
+
+    m_movesplineDelay = 0;
+}
+
 void Unit::DisableSpline()
 {
     _movementInfo.RemoveMovementFlag(MovementFlags(MOVEMENTFLAG_SPLINE_ENABLED | MOVEMENTFLAG_FORWARD));
@@ -526,6 +541,13 @@ void Unit::UpdateInterruptMask()
             m_interruptMask |= spell->m_spellInfo->ChannelInterruptFlags;
 }
 
+void Unit::UpdateProcAuraFlagMask()
+{
+    m_procAuraFlagMask = 0;
+    for (ProcAuraMap::const_iterator i = m_procAuras.begin(); i != m_procAuras.end(); ++i)
+        m_procAuraFlagMask |= i->second.second;
+}
+
 bool Unit::HasAuraTypeWithFamilyFlags(AuraType auraType, uint32 familyName, uint32 familyFlags, uint32 familyFlagsIndex) const
 {
     if (!HasAuraType(auraType))
@@ -3302,6 +3324,16 @@ AuraApplication * Unit::_CreateAuraApplication(Aura* aura, uint8 effMask)
     if (AuraStateType aState = aura->GetSpellInfo()->GetAuraState())
         m_auraStateAuras.insert(AuraStateAurasMap::value_type(aState, aurApp));
 
+    // proc flags can come from spell_proc_event as well as from the spell itself
+    uint32 procFlags = aurSpellInfo->ProcFlags;
+    if (SpellProcEventEntry const* spellProcEvent = sSpellMgr->GetSpellProcEvent(aurId))
+        procFlags |= spellProcEvent->procFlags;
+    if (procFlags)
+    {
+        m_procAuras.insert(ProcAuraMap::value_type(aurId, std::make_pair(aurApp, procFlags)));
+        m_procAuraFlagMask |= procFlags;
+    }
+
     aura->_ApplyForTarget(this, caster, aurApp);
     return aurApp;
 }
@@ -3383,6 +3415,16 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMo
         UpdateInterruptMask();
     }
 
+    for (ProcAuraMap::iterator itr = m_procAuras.lower_bound(aura->GetId()); itr != m_procAuras.upper_bound(aura->GetId()); ++itr)
+    {
+        if (itr->second.first == aurApp)
+        {
+            m_procAuras.erase(itr);
+            UpdateProcAuraFlagMask();
+            break;
+        }
+    }
+
     bool auraStateFound = false;
     AuraStateType auraState = aura->GetSpellInfo()->GetAuraState();
     if (auraState)
@@ -3485,6 +3527,46 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
         m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+
+    _InvalidateAuraModifierCache(aurEff->GetAuraType());
+}
+
+void Unit::_InvalidateAuraModifierCache(AuraType auraType)
+{
+    if (m_auraModifierCache.empty())
+        return;
+
+    // keys are ordered by aura type first, so all entries of one type form a single range
+    m_auraModifierCache.erase(m_auraModifierCache.lower_bound(MAKE_AURA_MODIFIER_CACHE_KEY(auraType, 0, 0)),
+        m_auraModifierCache.lower_bound(MAKE_AURA_MODIFIER_CACHE_KEY(auraType + 1, 0, 0)));
+}
+
+AuraModifierCacheEntry const& Unit::GetCachedAuraModifier(AuraType auratype, AuraModifierCacheKind kind, int32 misc) const
+{
+    static AuraModifierCacheEntry const emptyEntry;
+
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return emptyEntry;
+
+    uint64 key = MAKE_AURA_MODIFIER_CACHE_KEY(auratype, kind, misc);
+    AuraModifierCache::const_iterator itr = m_auraModifierCache.find(key);
+    if (itr != m_auraModifierCache.end())
+        return itr->second;
+
+    AuraModifierCacheEntry entry;
+    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    {
+        if (kind == AURA_MODIFIER_CACHE_MISC_VALUE && (*i)->GetMiscValue() != misc)
+            continue;
+        if (kind == AURA_MODIFIER_CACHE_MISC_MASK && !((*i)->GetMiscValue() & misc))
+            continue;
+
+        entry.modifier += (*i)->GetAmount();
+        AddPctN(entry.multiplier, (*i)->GetAmount());
+    }
+
+    return m_auraModifierCache.insert(std::make_pair(key, entry)).first->second;
 }
 
 // All aura base removes should go threw this function!
@@ -4421,24 +4503,12 @@ uint32 Unit::GetDoTsByCaster(uint64 casterGUID) const
 
 int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        modifier += (*i)->GetAmount();
-
-    return modifier;
+    return GetCachedAuraModifier(auratype, AURA_MODIFIER_CACHE_TOTAL, 0).modifier;
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        AddPctN(multiplier, (*i)->GetAmount());
-
-    return multiplier;
+    return GetCachedAuraModifier(auratype, AURA_MODIFIER_CACHE_TOTAL, 0).multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype)
@@ -4469,14 +4539,7 @@ int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetMiscValue() & misc_mask)
-            modifier += (*i)->GetAmount();
-
-    return modifier;
+    return GetCachedAuraModifier(auratype, AURA_MODIFIER_CACHE_MISC_MASK, int32(misc_mask)).modifier;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask) const
@@ -4534,28 +4597,12 @@ int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value)
-            modifier += (*i)->GetAmount();
-    }
-    return modifier;
+    return GetCachedAuraModifier(auratype, AURA_MODIFIER_CACHE_MISC_VALUE, misc_value).modifier;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value)
-            AddPctN(multiplier, (*i)->GetAmount());
-    }
-    return multiplier;
+    return GetCachedAuraModifier(auratype, AURA_MODIFIER_CACHE_MISC_VALUE, misc_value).multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
@@ -14764,19 +14811,27 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
         }
     }
 
+    // No applied aura can be triggered by any of the given proc flags
+    if (!(procFlag & m_procAuraFlagMask))
+        return;
+
+    // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
+    bool active = (damage > 0) || (procExtra & (PROC_EX_ABSORB|PROC_EX_BLOCK) && isVictim);
+    if (isVictim)
+        procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
+
     ProcTriggeredList procTriggered;
-    // Fill procTriggered list
-    for (AuraApplicationMap::const_iterator itr = GetAppliedAuras().begin(); itr!= GetAppliedAuras().end(); ++itr)
+    // Fill procTriggered list, only auras having at least one of the proc flags are checked
+    for (ProcAuraMap::const_iterator itr = m_procAuras.begin(); itr != m_procAuras.end(); ++itr)
     {
+        if (!(procFlag & itr->second.second))
+            continue;
         // Do not allow auras to proc from effect triggered by itself
         if (procAura && procAura->Id == itr->first)
             continue;
-        ProcTriggeredData triggerData(itr->second->GetBase());
-        // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
-        bool active = (damage > 0) || (procExtra & (PROC_EX_ABSORB|PROC_EX_BLOCK) && isVictim);
-        if (isVictim)
-            procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
-        SpellInfo const* spellProto = itr->second->GetBase()->GetSpellInfo();
+        AuraApplication* aurApp = itr->second.first;
+        ProcTriggeredData triggerData(aurApp->GetBase());
+        SpellInfo const* spellProto = aurApp->GetBase()->GetSpellInfo();
         if (!IsTriggeredAtSpellProcEvent(target, triggerData.aura, procSpell, procFlag, procExtra, attType, isVictim, active, triggerData.spellProcEvent))
             continue;
 
@@ -14786,9 +14841,9 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
 
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            if (itr->second->HasEffect(i))
+            if (aurApp->HasEffect(i))
             {
-                AuraEffect* aurEff = itr->second->GetBase()->GetEffect(i);
+                AuraEffect* aurEff = aurApp->GetBase()->GetEffect(i);
                 // Skip this auras
                 if (isNonTriggerAura[aurEff->GetAuraType()])
                     continue;
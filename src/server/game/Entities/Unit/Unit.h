@@ -1255,6 +1255,24 @@ enum PlayerTotemType
 
 struct SpellProcEventEntry;                                 // used only privately
 
+// Kind of aggregate stored in Unit::m_auraModifierCache
+enum AuraModifierCacheKind
+{
+    AURA_MODIFIER_CACHE_TOTAL       = 0,                    // all effects of the aura type
+    AURA_MODIFIER_CACHE_MISC_VALUE  = 1,                    // effects with MiscValue == misc
+    AURA_MODIFIER_CACHE_MISC_MASK   = 2                     // effects with MiscValue & misc
+};
+
+#define MAKE_AURA_MODIFIER_CACHE_KEY(T, K, M) ((uint64(T) << 40) | (uint64(K) << 32) | uint64(uint32(M)))
+
+struct AuraModifierCacheEntry
+{
+    AuraModifierCacheEntry() : modifier(0), multiplier(1.0f) {}
+
+    int32 modifier;                                         // sum of amounts
+    float multiplier;                                       // product of (100 + amount)%
+};
+
 class Unit : public WorldObject
 {
     public:
@@ -1271,6 +1289,8 @@ class Unit : public WorldObject
         typedef std::set<uint32> ComboPointHolderSet;
 
         typedef std::map<uint8, AuraApplication*> VisibleAuraMap;
+        typedef std::map<uint64, AuraModifierCacheEntry> AuraModifierCache;
+        typedef std::multimap<uint32, std::pair<AuraApplication*, uint32> > ProcAuraMap; // spell id -> (application, possible proc flags)
 
         virtual ~Unit ();
 
@@ -1789,6 +1809,7 @@ class Unit : public WorldObject
         void _RemoveNoStackAurasDueToAura(Aura * aura);
         bool _IsNoStackAuraDueToAura(Aura * appliedAura, Aura * existingAura) const;
         void _RegisterAuraEffect(AuraEffect * aurEff, bool apply);
+        void _InvalidateAuraModifierCache(AuraType auraType);
 
         // m_ownedAuras container management
         AuraMap      & GetOwnedAuras()       { return m_ownedAuras; }
@@ -2030,6 +2051,7 @@ class Unit : public WorldObject
         uint32 GetInterruptMask() const { return m_interruptMask; }
         void AddInterruptMask(uint32 mask) { m_interruptMask |= mask; }
         void UpdateInterruptMask();
+        void UpdateProcAuraFlagMask();
 
         uint32 GetDisplayId() { return GetUInt32Value(UNIT_FIELD_DISPLAYID); }
         void SetDisplayId(uint32 modelId);
@@ -2306,6 +2328,8 @@ class Unit : public WorldObject
 
         // Movement info
         Movement::MoveSpline* movespline;
+        // catches the spline up with the time UpdateSplineMovement has not applied yet, call before reading its progress
+        void UpdateSplineState() const;
 
     protected:
         explicit Unit (bool isWorldObject);
@@ -2348,10 +2372,13 @@ class Unit : public WorldObject
         uint32 m_removedAurasCount;
 
         AuraEffectList m_modAuras[TOTAL_AURAS];
+        mutable AuraModifierCache m_auraModifierCache;  // aggregated amounts of m_modAuras, reset per aura type on change
         AuraList m_scAuras;                        // casted singlecast auras
         AuraApplicationList m_interruptableAuras;  // auras which have interrupt mask applied on unit
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
         uint32 m_interruptMask;
+        ProcAuraMap m_procAuras;                   // applied auras which have proc flags, ordered like m_appliedAuras
+        uint32 m_procAuraFlagMask;                 // all proc flags of m_procAuras
 
         float _auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END];
         float m_weaponDamage[MAX_ATTACK][2];
@@ -2397,6 +2424,8 @@ class Unit : public WorldObject
         bool HandleAuraRaidProcFromChargeWithValue(AuraEffect* triggeredByAura);
         bool HandleAuraRaidProcFromCharge(AuraEffect* triggeredByAura);
 
+        AuraModifierCacheEntry const& GetCachedAuraModifier(AuraType auratype, AuraModifierCacheKind kind, int32 misc) const;
+
         void UpdateSplineMovement(uint32 t_diff);
 
         // player or player's pet
@@ -2414,6 +2443,7 @@ class Unit : public WorldObject
         uint32 m_CombatTimer;
         uint32 m_lastManaUse;                               // msecs
         TimeTrackerSmall m_movesplineTimer;
+        mutable uint32 m_movesplineDelay;                   // msecs of spline movement not applied yet
 
         Diminishing m_Diminishing;
         // Manage all Units that are threatened by us
@@ -164,6 +164,21 @@ Unit* ObjectAccessor::FindUnit(uint64 guid)
     return GetObjectInWorld(guid, (Unit*)NULL);
 }
 
+void ObjectAccessor::FindPlayers(std::vector<uint64> const& guids, std::vector<Player*>& players)
+{
+    players.reserve(players.size() + guids.size());
+
+    SKYFIRE_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
+    HashMapHolder<Player>::MapType const& m = GetPlayers();
+    for (std::vector<uint64>::const_iterator itr = guids.begin(); itr != guids.end(); ++itr)
+    {
+        HashMapHolder<Player>::MapType::const_iterator iter = m.find(*itr);
+        // Player may be not in world while in ObjectAccessor
+        if (iter != m.end() && iter->second->IsInWorld())
+            players.push_back(iter->second);
+    }
+}
+
 Player* ObjectAccessor::FindPlayerByName(const char* name)
 {
     SKYFIRE_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
@@ -195,6 +195,8 @@ class ObjectAccessor
         static Creature* FindCreature(uint64);
         static Unit* FindUnit(uint64);
         static Player* FindPlayerByName(const char* name);
+        // resolves the in world players of all guids locking the player storage only once
+        static void FindPlayers(std::vector<uint64> const& guids, std::vector<Player*>& players);
 
         // when using this, you must use the hashmapholder's lock
         static HashMapHolder<Player>::MapType const& GetPlayers()
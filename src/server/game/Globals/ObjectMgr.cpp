@@ -48,6 +48,7 @@
 #include "SpellScript.h"
 #include "PoolMgr.h"
 #include "DB2Stores.h"
+#include "WorldSnapshot.h"
 
 ScriptMapMap sQuestEndScripts;
 ScriptMapMap sQuestStartScripts;
@@ -506,6 +507,7 @@ void ObjectMgr::LoadCreatureTemplates()
         creatureTemplate.MechanicImmuneMask = fields[81].GetUInt32();
         creatureTemplate.flags_extra        = fields[82].GetUInt32();
         creatureTemplate.ScriptID           = GetScriptId(fields[83].GetCString());
+        creatureTemplate.InitAIProfile();
 
         ++count;
     }
@@ -1407,12 +1409,40 @@ bool ObjectMgr::SetCreatureLinkedRespawn(uint32 guidLow, uint32 linkedGuidLow)
     return true;
 }
 
+// Validated `creature` row as stored in the world snapshot
+struct CreatureSnapshotRecord
+{
+    uint32 guid;
+    bool addToGrid;
+    CreatureData data;
+};
+
 void ObjectMgr::LoadCreatures()
 {
     uint32 oldMSTime = getMSTime();
 
+    WorldSnapshot snapshot("creature", "creature, game_event_creature, pool_creature, creature_template, creature_equip_template");
+    std::vector<CreatureSnapshotRecord> records;
+    if (snapshot.Read(records))
+    {
+        _creatureDataStore.rehash(records.size());
+        for (std::vector<CreatureSnapshotRecord>::const_iterator itr = records.begin(); itr != records.end(); ++itr)
+        {
+            CreatureData& data = _creatureDataStore[itr->guid];
+            data = itr->data;
+            if (itr->addToGrid)
+                AddCreatureToGrid(itr->guid, &data);
+        }
+
+        sLog->outString(">> Loaded %u creatures from snapshot in %u ms", uint32(records.size()), GetMSTimeDiffToNow(oldMSTime));
+        sLog->outString();
+        return;
+    }
+    records.clear();
+
     //                                                         0     1   2      3           4            5         6            7           8            9            10
-    QueryResult result = WorldDatabase.Query("SELECT creature.guid, id, map, modelid, equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, spawndist, "
+    // Streamed, the loop below must not query the world database
+    QueryResult result = WorldDatabase.StreamQuery("SELECT creature.guid, id, map, modelid, equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, spawndist, "
     //          11            12        13        14           15           16        17          18          19                 20                  21
         "currentwaypoint, curhealth, curmana, MovementType, spawnMask, phaseMask, eventEntry, pool_entry, creature.npcflag, creature.unit_flags, creature.dynamicflags "
         "FROM creature "
@@ -1434,7 +1464,6 @@ void ObjectMgr::LoadCreatures()
                 if (GetMapDifficultyData(i, Difficulty(k)))
                     spawnMasks[i] |= (1 << k);
 
-    _creatureDataStore.rehash(result->GetRowCount());
     uint32 count = 0;
     do
     {
@@ -1544,9 +1573,27 @@ void ObjectMgr::LoadCreatures()
         if (gameEvent == 0 && PoolId == 0)
             AddCreatureToGrid(guid, &data);
 
+        if (snapshot.IsEnabled())
+        {
+            CreatureSnapshotRecord record;
+            record.guid = guid;
+            record.addToGrid = gameEvent == 0 && PoolId == 0;
+            record.data = data;
+            records.push_back(record);
+        }
+
         ++count;
     } while (result->NextRow());
 
+    // a partial spawn list must neither start the world nor end up in the snapshot
+    if (result->HasStreamError())
+    {
+        sLog->outError("Loading of `creature` stopped after %u rows, the world database connection failed.", count);
+        exit(1);
+    }
+
+    snapshot.Write(records);
+
     sLog->outString(">> Loaded %u creatures in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
     sLog->outString();
 }
@@ -1717,14 +1764,42 @@ uint32 ObjectMgr::AddCreData(uint32 entry, uint32 /*team*/, uint32 mapId, float
     return guid;
 }
 
+// Validated `gameobject` row as stored in the world snapshot
+struct GameObjectSnapshotRecord
+{
+    uint32 guid;
+    bool addToGrid;
+    GameObjectData data;
+};
+
 void ObjectMgr::LoadGameobjects()
 {
     uint32 oldMSTime = getMSTime();
 
+    WorldSnapshot snapshot("gameobject", "gameobject, game_event_gameobject, pool_gameobject, gameobject_template");
+    std::vector<GameObjectSnapshotRecord> records;
+    if (snapshot.Read(records))
+    {
+        _gameObjectDataStore.rehash(records.size());
+        for (std::vector<GameObjectSnapshotRecord>::const_iterator itr = records.begin(); itr != records.end(); ++itr)
+        {
+            GameObjectData& data = _gameObjectDataStore[itr->guid];
+            data = itr->data;
+            if (itr->addToGrid)
+                AddGameobjectToGrid(itr->guid, &data);
+        }
+
+        sLog->outString(">> Loaded %u gameobjects from snapshot in %u ms", uint32(records.size()), GetMSTimeDiffToNow(oldMSTime));
+        sLog->outString();
+        return;
+    }
+    records.clear();
+
     uint32 count = 0;
 
     //                                                0                1   2    3           4           5           6
-    QueryResult result = WorldDatabase.Query("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, "
+    // Streamed, the loop below must not query the world database
+    QueryResult result = WorldDatabase.StreamQuery("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, "
     //   7          8          9          10         11             12            13     14         15             16          17
         "rotation0, rotation1, rotation2, rotation3, spawntimesecs, animprogress, state, spawnMask, phaseMask, eventEntry, pool_entry "
         "FROM gameobject LEFT OUTER JOIN game_event_gameobject ON gameobject.guid = game_event_gameobject.guid "
@@ -1745,7 +1820,6 @@ void ObjectMgr::LoadGameobjects()
                 if (GetMapDifficultyData(i, Difficulty(k)))
                     spawnMasks[i] |= (1 << k);
 
-    _gameObjectDataStore.rehash(result->GetRowCount());
     do
     {
         Field *fields = result->Fetch();
@@ -1848,9 +1922,27 @@ void ObjectMgr::LoadGameobjects()
 
         if (gameEvent == 0 && PoolId == 0)                      // if not this is to be managed by GameEvent System or Pool system
             AddGameobjectToGrid(guid, &data);
+
+        if (snapshot.IsEnabled())
+        {
+            GameObjectSnapshotRecord record;
+            record.guid = guid;
+            record.addToGrid = gameEvent == 0 && PoolId == 0;
+            record.data = data;
+            records.push_back(record);
+        }
+
         ++count;
     } while (result->NextRow());
 
+    if (result->HasStreamError())
+    {
+        sLog->outError("Loading of `gameobject` stopped after %u rows, the world database connection failed.", count);
+        exit(1);
+    }
+
+    snapshot.Write(records);
+
     sLog->outString(">> Loaded %lu gameobjects in %u ms", (unsigned long)_gameObjectDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
     sLog->outString();
 }
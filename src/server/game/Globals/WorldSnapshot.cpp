@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorldSnapshot.h"
+#include "DatabaseEnv.h"
+#include "World.h"
+
+struct WorldSnapshotHeader
+{
+    char magic[4];
+    uint32 version;
+    uint32 recordSize;
+    uint32 count;
+    uint64 checksum;
+};
+
+static const char WorldSnapshotMagic[4] = { 'W', 'S', 'N', 'P' };
+
+WorldSnapshot::WorldSnapshot(const char* name, const char* tables) : m_name(name), m_file(NULL), m_checksum(0),
+    m_enabled(sWorld->getBoolConfig(CONFIG_WORLD_SNAPSHOT_ENABLE))
+{
+    if (!m_enabled)
+        return;
+
+    m_fileName = sWorld->GetDataPath() + "snapshots/" + m_name + ".snapshot";
+
+    // one (Table, Checksum) row per table
+    QueryResult result = WorldDatabase.PQuery("CHECKSUM TABLE %s", tables);
+    if (!result)
+    {
+        sLog->outError("WorldSnapshot: can't checksum tables of snapshot '%s', not using it.", m_name.c_str());
+        m_enabled = false;
+        return;
+    }
+
+    // FNV-1a over the checksum of every table, a missing table (NULL checksum) counts as 0
+    m_checksum = UI64LIT(14695981039346656037);
+    do
+    {
+        Field* fields = result->Fetch();
+        m_checksum = (m_checksum ^ fields[1].GetUInt64()) * UI64LIT(1099511628211);
+    }
+    while (result->NextRow());
+}
+
+WorldSnapshot::~WorldSnapshot()
+{
+    if (m_file)
+        fclose(m_file);
+}
+
+bool WorldSnapshot::ReadHeader(uint32 recordSize, uint32& count)
+{
+    if (!m_enabled)
+        return false;
+
+    m_file = fopen(m_fileName.c_str(), "rb");
+    if (!m_file)
+        return false;
+
+    WorldSnapshotHeader header;
+    if (fread(&header, sizeof(header), 1, m_file) != 1 || memcmp(header.magic, WorldSnapshotMagic, sizeof(header.magic)) != 0)
+    {
+        sLog->outError("WorldSnapshot: file '%s' is corrupted, rebuilding it.", m_fileName.c_str());
+        return false;
+    }
+
+    if (header.version != WORLD_SNAPSHOT_VERSION || header.recordSize != recordSize || header.checksum != m_checksum)
+    {
+        sLog->outDetail("WorldSnapshot: snapshot '%s' is outdated, rebuilding it.", m_name.c_str());
+        return false;
+    }
+
+    count = header.count;
+    return true;
+}
+
+bool WorldSnapshot::ReadRecords(void* data, uint32 recordSize, uint32 count)
+{
+    bool ok = !count || fread(data, recordSize, count, m_file) == count;
+    fclose(m_file);
+    m_file = NULL;
+
+    if (!ok)
+        sLog->outError("WorldSnapshot: file '%s' is truncated, rebuilding it.", m_fileName.c_str());
+
+    return ok;
+}
+
+void WorldSnapshot::WriteRecords(void const* data, uint32 recordSize, uint32 count)
+{
+    if (!m_enabled)
+        return;
+
+    if (m_file)
+    {
+        fclose(m_file);
+        m_file = NULL;
+    }
+
+    // write to a temporary file first so a crash never leaves a half written snapshot behind
+    std::string tmpFileName = m_fileName + ".tmp";
+    FILE* file = fopen(tmpFileName.c_str(), "wb");
+    if (!file)
+    {
+        sLog->outError("WorldSnapshot: can't create '%s', does the snapshots directory exist?", tmpFileName.c_str());
+        return;
+    }
+
+    WorldSnapshotHeader header;
+    memcpy(header.magic, WorldSnapshotMagic, sizeof(header.magic));
+    header.version = WORLD_SNAPSHOT_VERSION;
+    header.recordSize = recordSize;
+    header.count = count;
+    header.checksum = m_checksum;
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 && (!count || fwrite(data, recordSize, count, file) == count);
+    ok = fclose(file) == 0 && ok;
+
+    if (ok)
+    {
+        remove(m_fileName.c_str());
+        ok = rename(tmpFileName.c_str(), m_fileName.c_str()) == 0;
+    }
+
+    if (!ok)
+    {
+        sLog->outError("WorldSnapshot: failed to write '%s'.", m_fileName.c_str());
+        remove(tmpFileName.c_str());
+        return;
+    }
+
+    sLog->outDetail("WorldSnapshot: written %u records to '%s'.", count, m_fileName.c_str());
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _WORLD_SNAPSHOT_H
+#define _WORLD_SNAPSHOT_H
+
+#include "Define.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Bump when the validation done by a snapshotted loader or the layout of a record changes
+#define WORLD_SNAPSHOT_VERSION 1
+
+/*
+ * Binary copy of the validated rows of a world store, kept in <DataDir>/snapshots/.
+ * A snapshot is only used while the CHECKSUM TABLE of all its source tables is
+ * unchanged, otherwise the loader reads the database and writes a new one.
+ * Records are written as raw memory, so they must be plain data structures.
+ */
+class WorldSnapshot
+{
+    public:
+        // tables: comma separated list of every table the loader reads
+        WorldSnapshot(const char* name, const char* tables);
+        ~WorldSnapshot();
+
+        bool IsEnabled() const { return m_enabled; }
+
+        template<class T>
+        bool Read(std::vector<T>& records)
+        {
+            uint32 count = 0;
+            if (!ReadHeader(sizeof(T), count))
+                return false;
+
+            records.resize(count);
+            return ReadRecords(count ? &records[0] : NULL, sizeof(T), count);
+        }
+
+        template<class T>
+        void Write(std::vector<T> const& records)
+        {
+            WriteRecords(records.empty() ? NULL : &records[0], sizeof(T), uint32(records.size()));
+        }
+
+    private:
+        // opens the file and checks its header, leaving it positioned at the first record
+        bool ReadHeader(uint32 recordSize, uint32& count);
+        bool ReadRecords(void* data, uint32 recordSize, uint32 count);
+        void WriteRecords(void const* data, uint32 recordSize, uint32 count);
+
+        std::string m_name;
+        std::string m_fileName;
+        FILE* m_file;
+        uint64 m_checksum;
+        bool m_enabled;
+};
+
+#endif
@@ -33,14 +33,18 @@ using namespace SkyFire;
 
 void VisibleNotifier::SendToSelf()
 {
-    // at this moment i_clientGUIDs have guids that not iterate at grid level checks
+    std::sort(i_seenGUIDs.begin(), i_seenGUIDs.end());
+
+    // at this moment the client GUIDs not seen are the ones that not iterate at grid level checks
     // but exist one case when this possible and object not out of range: transports
     if (Transport* transport = i_player.GetTransport())
         for (Transport::PlayerSet::const_iterator itr = transport->GetPassengers().begin();itr != transport->GetPassengers().end();++itr)
         {
-            if (vis_guids.find((*itr)->GetGUID()) != vis_guids.end())
+            uint64 guid = (*itr)->GetGUID();
+            GUIDList::iterator seen = std::lower_bound(i_seenGUIDs.begin(), i_seenGUIDs.end(), guid);
+            if ((seen == i_seenGUIDs.end() || *seen != guid) && i_player.m_clientGUIDs.find(guid) != i_player.m_clientGUIDs.end())
             {
-                vis_guids.erase((*itr)->GetGUID());
+                i_seenGUIDs.insert(seen, guid);
 
                 i_player.UpdateVisibilityOf((*itr), i_data, i_visibleNow);
 
@@ -49,7 +53,14 @@ void VisibleNotifier::SendToSelf()
             }
         }
 
-    for (Player::ClientGUIDs::const_iterator it = vis_guids.begin();it != vis_guids.end(); ++it)
+    GUIDList outOfRange;
+    for (Player::ClientGUIDs::const_iterator it = i_player.m_clientGUIDs.begin(); it != i_player.m_clientGUIDs.end(); ++it)
+        if (!std::binary_search(i_seenGUIDs.begin(), i_seenGUIDs.end(), *it))
+            outOfRange.push_back(*it);
+
+    i_player.GetMap()->AddVisibilityWork(i_seenGUIDs.size());
+
+    for (GUIDList::const_iterator it = outOfRange.begin();it != outOfRange.end(); ++it)
     {
         i_player.m_clientGUIDs.erase(*it);
         i_data.AddOutOfRangeGUID(*it);
@@ -125,7 +136,7 @@ void PlayerRelocationNotifier::Visit(PlayerMapType &m)
     {
         Player* player = iter->getSource();
 
-        vis_guids.erase(player->GetGUID());
+        Seen(player);
 
         i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
 
@@ -144,7 +155,7 @@ void PlayerRelocationNotifier::Visit(CreatureMapType &m)
     {
         Creature* c = iter->getSource();
 
-        vis_guids.erase(c->GetGUID());
+        Seen(c);
 
         i_player.UpdateVisibilityOf(c, i_data, i_visibleNow);
 
@@ -306,6 +317,55 @@ void MessageDistDeliverer::Visit(DynamicObjectMapType &m)
     }
 }
 
+void MonsterMoveDeliverer::Visit(PlayerMapType &m)
+{
+    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        Player* target = iter->getSource();
+
+        if (!target->GetSharedVisionList().empty())
+        {
+            SharedVisionList::const_iterator i = target->GetSharedVisionList().begin();
+            for (; i != target->GetSharedVisionList().end(); ++i)
+                if ((*i)->_seer == target)
+                    SendPackets(target, *i);
+        }
+
+        if (target->_seer == target || target->GetVehicle())
+            SendPackets(target, target);
+    }
+}
+
+void MonsterMoveDeliverer::Visit(CreatureMapType &m)
+{
+    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        Creature* target = iter->getSource();
+        if (target->GetSharedVisionList().empty())
+            continue;
+
+        SharedVisionList::const_iterator i = target->GetSharedVisionList().begin();
+        for (; i != target->GetSharedVisionList().end(); ++i)
+            if ((*i)->_seer == target)
+                SendPackets(target, *i);
+    }
+}
+
+void MonsterMoveDeliverer::Visit(DynamicObjectMapType &m)
+{
+    for (DynamicObjectMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        DynamicObject* target = iter->getSource();
+        if (!IS_PLAYER_GUID(target->GetCasterGUID()))
+            continue;
+
+        // send packets back to the caster if the caster has vision of dynamic object
+        Player* caster = (Player*)target->GetCaster();
+        if (caster && caster->_seer == target)
+            SendPackets(target, caster);
+    }
+}
+
 /*
 void
 MessageDistDeliverer::VisitObject(Player* player)
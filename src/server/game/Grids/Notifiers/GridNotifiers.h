@@ -43,11 +43,15 @@ namespace SkyFire
         Player &i_player;
         UpdateData i_data;
         std::set<Unit*> i_visibleNow;
-        Player::ClientGUIDs vis_guids;
+        // GUIDs of every object met during the visit, client GUIDs missing here go out of range
+        typedef std::vector<uint64, TickArenaAllocator<uint64> > GUIDList;
+        GUIDList i_seenGUIDs;
 
-        VisibleNotifier(Player &player) : i_player(player), i_data(player.GetMapId()), vis_guids(player.m_clientGUIDs) {}
+        VisibleNotifier(Player &player) : i_player(player), i_data(player.GetMapId()) {}
         template<class T> void Visit(GridRefManager<T> &m);
         void SendToSelf(void);
+
+        void Seen(WorldObject const* object) { i_seenGUIDs.push_back(object->GetGUID()); }
     };
 
     struct VisibleChangesNotifier
@@ -148,6 +152,41 @@ namespace SkyFire
         }
     };
 
+    struct MonsterMove
+    {
+        Unit* mover;
+        WorldPacket const* packet;
+        float distSq;                                       // squared visibility range of the mover
+    };
+
+    // delivers the monster moves of a group of close creatures in one visit, see Map::SendMonsterMoves
+    struct MonsterMoveDeliverer
+    {
+        MonsterMove const* i_begin;
+        MonsterMove const* i_end;
+        MonsterMoveDeliverer(MonsterMove const* begin, MonsterMove const* end) : i_begin(begin), i_end(end) {}
+        void Visit(PlayerMapType &m);
+        void Visit(CreatureMapType &m);
+        void Visit(DynamicObjectMapType &m);
+        template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
+
+        // same rules as MessageDistDeliverer, for every move seen from the view point
+        template<class VIEWPOINT> void SendPackets(VIEWPOINT* viewPoint, Player* player)
+        {
+            for (MonsterMove const* move = i_begin; move != i_end; ++move)
+            {
+                if (!viewPoint->InSamePhase(move->mover->GetPhaseMask()) || viewPoint->GetExactDist2dSq(move->mover) > move->distSq)
+                    continue;
+
+                if (!player->HaveAtClient(move->mover))
+                    continue;
+
+                if (WorldSession* session = player->GetSession())
+                    session->SendPacket(move->packet);
+            }
+        }
+    };
+
     struct ObjectUpdater
     {
         uint32 i_timeDiff;
@@ -33,7 +33,7 @@ inline void SkyFire::VisibleNotifier::Visit(GridRefManager<T> &m)
 {
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
-        vis_guids.erase(iter->getSource()->GetGUID());
+        Seen(iter->getSource());
         i_player.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
     }
 }
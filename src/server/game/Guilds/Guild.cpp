@@ -2403,27 +2403,37 @@ void Guild::BroadcastToGuild(WorldSession* session, bool officerOnly, const std:
     {
         WorldPacket data;
         ChatHandler::FillMessageData(&data, session, officerOnly ? CHAT_MSG_OFFICER : CHAT_MSG_GUILD, language, NULL, 0, msg.c_str(), NULL);
+
+        // Rank rights are checked on the member data so only listeners are looked up
+        uint32 listenRight = officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN;
+        std::vector<uint64> guids;
+        guids.reserve(m_members.size());
         for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-            if (Player* player = itr->second->FindPlayer())
-                if (player->GetSession() && _HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) &&
-                    !player->GetSocial()->HasIgnore(session->GetPlayer()->GetGUIDLow()))
-                    player->GetSession()->SendPacket(&data);
+            if (_GetRankRights(itr->second->GetRankId()) & listenRight)
+                guids.push_back(itr->second->GetGUID());
+
+        WorldSession::BroadcastPacket(&data, guids, session->GetPlayer()->GetGUID());
     }
 }
 
 void Guild::BroadcastPacketToRank(WorldPacket* packet, uint8 rankId) const
 {
+    std::vector<uint64> guids;
     for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
         if (itr->second->IsRank(rankId))
-            if (Player* player = itr->second->FindPlayer())
-                player->GetSession()->SendPacket(packet);
+            guids.push_back(itr->second->GetGUID());
+
+    WorldSession::BroadcastPacket(packet, guids);
 }
 
 void Guild::BroadcastPacket(WorldPacket* packet) const
 {
+    std::vector<uint64> guids;
+    guids.reserve(m_members.size());
     for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-        if (Player* player = itr->second->FindPlayer())
-            player->GetSession()->SendPacket(packet);
+        guids.push_back(itr->second->GetGUID());
+
+    WorldSession::BroadcastPacket(packet, guids);
 }
 
 // Members handling
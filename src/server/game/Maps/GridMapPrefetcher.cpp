@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridMapPrefetcher.h"
+#include "Map.h"
+#include "World.h"
+#include "Timer.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Method_Request.h>
+
+// prefetched terrain is dropped when no player entered its grid in this time
+#define GRID_PREFETCH_EXPIRY (60 * IN_MILLISECONDS)
+
+class GridMapPrefetchRequest : public ACE_Method_Request
+{
+    public:
+
+        GridMapPrefetchRequest(GridMapPrefetcher& prefetcher, uint32 mapId, uint32 gx, uint32 gy)
+            : m_prefetcher(prefetcher), m_mapId(mapId), m_gx(gx), m_gy(gy)
+        {
+        }
+
+        virtual int call()
+        {
+            uint32 key = GridMapPrefetcher::MakeKey(m_mapId, m_gx, m_gy);
+            // Map::LoadMap took the grid before its turn came and read the file itself
+            if (!m_prefetcher.StartLoading(key))
+                return 0;
+
+            std::string dataPath = sWorld->GetDataPath();
+            char fileName[512];
+
+            snprintf(fileName, sizeof(fileName), "%smaps/%03u%02u%02u.map", dataPath.c_str(), m_mapId, m_gx, m_gy);
+            GridMap* gridMap = new GridMap();
+            if (!gridMap->loadData(fileName))
+            {
+                // let Map::LoadMap load it again and report the error
+                delete gridMap;
+                gridMap = NULL;
+            }
+
+            m_prefetcher.Loaded(key, gridMap);
+
+            // file names as built by StaticMapTree::getTileFileName and MMapManager::loadMap
+            snprintf(fileName, sizeof(fileName), "%svmaps/%03u_%02u_%02u.vmtile", dataPath.c_str(), m_mapId, m_gy, m_gx);
+            ReadFile(fileName);
+            snprintf(fileName, sizeof(fileName), "%smmaps/%03u%02u%02u.mmtile", dataPath.c_str(), m_mapId, m_gx, m_gy);
+            ReadFile(fileName);
+            return 0;
+        }
+
+    private:
+
+        // reads a file and throws the data away, missing files are fine
+        static void ReadFile(char const* fileName)
+        {
+            FILE* file = fopen(fileName, "rb");
+            if (!file)
+                return;
+
+            char buffer[16 * 1024];
+            while (fread(buffer, 1, sizeof(buffer), file) == sizeof(buffer))
+                ;
+
+            fclose(file);
+        }
+
+        GridMapPrefetcher& m_prefetcher;
+        uint32 m_mapId;
+        uint32 m_gx;
+        uint32 m_gy;
+};
+
+GridMapPrefetcher::GridMapPrefetcher() : m_condition(m_lock)
+{
+    memset(&m_stats, 0, sizeof(m_stats));
+}
+
+GridMapPrefetcher::~GridMapPrefetcher()
+{
+    Deactivate();
+}
+
+void GridMapPrefetcher::Activate()
+{
+    if (m_executor.activated())
+        return;
+
+    if (m_executor.activate(1) == -1)
+        sLog->outError("GridMapPrefetcher: can't start the loader thread, grids are loaded by the map threads.");
+}
+
+void GridMapPrefetcher::Deactivate()
+{
+    m_executor.deactivate();
+
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    for (EntryMap::iterator itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+        delete itr->second.gridMap;
+
+    m_entries.clear();
+    m_condition.broadcast();
+}
+
+void GridMapPrefetcher::Request(uint32 mapId, uint32 gx, uint32 gy)
+{
+    if (!m_executor.activated())
+        return;
+
+    uint32 key = MakeKey(mapId, gx, gy);
+    {
+        SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+        if (!m_entries.insert(EntryMap::value_type(key, Entry())).second)
+            return;
+
+        ++m_stats.requested;
+    }
+
+    sLog->outDebug(LOG_FILTER_MAPS, "GridMapPrefetcher: prefetching map %u grid [%u, %u]", mapId, gx, gy);
+    if (m_executor.execute(new GridMapPrefetchRequest(*this, mapId, gx, gy)) == -1)
+    {
+        SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+        m_entries.erase(key);
+    }
+}
+
+GridMap* GridMapPrefetcher::Take(uint32 mapId, uint32 gx, uint32 gy)
+{
+    uint32 key = MakeKey(mapId, gx, gy);
+
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    EntryMap::iterator itr = m_entries.find(key);
+    if (itr == m_entries.end())
+        return NULL;
+
+    // still queued behind other grids, reading the file here is faster than waiting
+    if (itr->second.state == ENTRY_QUEUED)
+    {
+        m_entries.erase(itr);
+        return NULL;
+    }
+
+    // the loader is already reading the file, waiting is cheaper than reading it twice
+    while (itr != m_entries.end() && itr->second.state == ENTRY_LOADING)
+    {
+        m_condition.wait();
+        itr = m_entries.find(key);
+    }
+
+    if (itr == m_entries.end())
+        return NULL;
+
+    GridMap* gridMap = itr->second.gridMap;
+    m_entries.erase(itr);
+    if (gridMap)
+        ++m_stats.used;
+
+    return gridMap;
+}
+
+bool GridMapPrefetcher::StartLoading(uint32 key)
+{
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    EntryMap::iterator itr = m_entries.find(key);
+    if (itr == m_entries.end() || itr->second.state != ENTRY_QUEUED)
+        return false;
+
+    itr->second.state = ENTRY_LOADING;
+    return true;
+}
+
+void GridMapPrefetcher::Loaded(uint32 key, GridMap* gridMap)
+{
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    EntryMap::iterator itr = m_entries.find(key);
+    if (itr == m_entries.end())
+    {
+        delete gridMap;
+        return;
+    }
+
+    itr->second.gridMap = gridMap;
+    itr->second.loadTime = getMSTime();
+    itr->second.state = ENTRY_LOADED;
+    m_condition.broadcast();
+}
+
+void GridMapPrefetcher::Update()
+{
+    uint32 now = getMSTime();
+
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    for (EntryMap::iterator itr = m_entries.begin(); itr != m_entries.end();)
+    {
+        if (itr->second.state == ENTRY_LOADED && getMSTimeDiff(itr->second.loadTime, now) > GRID_PREFETCH_EXPIRY)
+        {
+            delete itr->second.gridMap;
+            ++m_stats.expired;
+            m_entries.erase(itr++);
+        }
+        else
+            ++itr;
+    }
+}
+
+void GridMapPrefetcher::GetStats(Stats& stats)
+{
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    stats = m_stats;
+    stats.pending = uint32(m_entries.size());
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GRID_MAP_PREFETCHER_H
+#define _GRID_MAP_PREFETCHER_H
+
+#include "Common.h"
+#include "DelayExecutor.h"
+
+#include <ace/Singleton.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+class GridMap;
+
+/*
+ * Loads the terrain (.map file) of grids players are heading to on a background
+ * thread, and reads their vmap and mmap tiles once so the file cache is warm.
+ * Map::LoadMap takes the prefetched GridMap instead of reading the file itself;
+ * vmap/mmap tiles and grid objects are still loaded by the map thread, their
+ * managers and the grid containers are not thread safe.
+ */
+class GridMapPrefetcher
+{
+    friend class ACE_Singleton<GridMapPrefetcher, ACE_Thread_Mutex>;
+    friend class GridMapPrefetchRequest;
+
+    public:
+        struct Stats
+        {
+            uint32 requested;
+            uint32 used;                                    // taken by Map::LoadMap
+            uint32 expired;                                 // dropped without being used
+            uint32 pending;                                 // queued, loading or waiting to be taken
+        };
+
+        void Activate();
+        void Deactivate();
+        bool IsActive() { return m_executor.activated(); }
+
+        // queues the grid for loading unless it is already queued or loaded
+        void Request(uint32 mapId, uint32 gx, uint32 gy);
+        // hands over the prefetched terrain of a grid, waiting for it if it is being loaded.
+        // NULL if the grid was not requested, is still queued or its file could not be loaded.
+        GridMap* Take(uint32 mapId, uint32 gx, uint32 gy);
+        // drops terrain nobody took within GRID_PREFETCH_EXPIRY, called by the world thread
+        void Update();
+
+        void GetStats(Stats& stats);
+
+    private:
+        GridMapPrefetcher();
+        ~GridMapPrefetcher();
+
+        enum EntryState
+        {
+            ENTRY_QUEUED,                                   // waiting for the loader thread
+            ENTRY_LOADING,                                  // the loader thread reads the .map file
+            ENTRY_LOADED                                    // waiting to be taken
+        };
+
+        struct Entry
+        {
+            Entry() : gridMap(NULL), loadTime(0), state(ENTRY_QUEUED) {}
+
+            GridMap* gridMap;
+            uint32 loadTime;
+            EntryState state;
+        };
+
+        typedef UNORDERED_MAP<uint32, Entry> EntryMap;
+
+        static uint32 MakeKey(uint32 mapId, uint32 gx, uint32 gy) { return (mapId << 16) | (gx << 8) | gy; }
+
+        // false if the grid was taken while it was queued
+        bool StartLoading(uint32 key);
+        void Loaded(uint32 key, GridMap* gridMap);
+
+        DelayExecutor m_executor;
+        ACE_Thread_Mutex m_lock;                            // protects the members below
+        ACE_Condition_Thread_Mutex m_condition;             // signalled when a grid finished loading
+        EntryMap m_entries;
+        Stats m_stats;
+};
+
+#define sGridMapPrefetcher ACE_Singleton<GridMapPrefetcher, ACE_Thread_Mutex>::instance()
+
+#endif
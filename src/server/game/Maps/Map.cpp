@@ -34,6 +34,8 @@
 #include "Group.h"
 #include "LFGMgr.h"
 #include "Vehicle.h"
+#include "GridMapPrefetcher.h"
+#include "MapCapture.h"
 
 union u_map_magic
 {
@@ -185,6 +187,17 @@ void Map::LoadMap(int gx, int gy, bool reload)
         delete (GridMaps[gx][gy]);
         GridMaps[gx][gy]=NULL;
     }
+    else if (sGridMapPrefetcher->IsActive())
+    {
+        // terrain already read by the prefetcher
+        if (GridMap* gridMap = sGridMapPrefetcher->Take(GetId(), gx, gy))
+        {
+            sLog->outDetail("Using prefetched map %03u%02u%02u", GetId(), gx, gy);
+            GridMaps[gx][gy] = gridMap;
+            sScriptMgr->OnLoadGridMap(this, gridMap, gx, gy);
+            return;
+        }
+    }
 
     // map file name
     char *tmp=NULL;
@@ -232,7 +245,8 @@ _creatureToMoveLock(false), i_mapEntry (sMapStore.LookupEntry(id)), i_spawnMode(
 m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), i_gridExpiry(expiry),
-i_scriptLock(false)
+i_scriptLock(false), m_crowdCheckTimer(0), m_visibilityNotifies(0), m_visibilityObjects(0),
+m_monsterMoveBatching(false)
 {
     m_parentMap = (_parent ? _parent : this);
     for (unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
@@ -421,6 +435,7 @@ bool Map::AddPlayerToMap(Player* player)
     ASSERT (player->GetMap() == this);
     player->SetMap(this);
     player->AddToWorld();
+    sMapCapture->OnPlayerAdded(this, player);
 
     SendInitSelf(player);
     SendInitTransports(player);
@@ -522,8 +537,49 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<SkyFire::Obj
     }
 }
 
+uint32 const MapUpdateStats::BucketLimits[MAP_UPDATE_TIME_BUCKETS] = { 5, 10, 25, 50, 100, 250, 500, 0xFFFFFFFF };
+
+MapUpdateStats::MapUpdateStats() : count(0), last(0), max(0), total(0), visibilityNotifies(0), visibilityObjects(0)
+{
+    memset(buckets, 0, sizeof(buckets));
+}
+
+void MapUpdateStats::Add(uint32 duration)
+{
+    uint32 bucket = 0;
+    while (duration > BucketLimits[bucket])
+        ++bucket;
+
+    ++buckets[bucket];
+    ++count;
+    last = duration;
+    total += duration;
+    if (duration > max)
+        max = duration;
+}
+
+void Map::TimedUpdate(const uint32 diff)
+{
+    sMapCapture->OnMapUpdate(this);
+
+    uint32 oldMSTime = getMSTime();
+    Update(diff);
+    m_updateStats.Add(GetMSTimeDiffToNow(oldMSTime));
+
+    // also counts visibility updates done for this map since the previous update outside of it
+    m_updateStats.visibilityNotifies = m_visibilityNotifies;
+    m_updateStats.visibilityObjects = m_visibilityObjects;
+    m_visibilityNotifies = 0;
+    m_visibilityObjects = 0;
+}
+
 void Map::Update(const uint32 t_diff)
 {
+    TickArena::Scope arenaScope(_tickArena);
+
+    // queue creature splines launched from here on, SendMonsterMoves delivers them together
+    m_monsterMoveBatching = true;
+
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
@@ -582,12 +638,75 @@ void Map::Update(const uint32 t_diff)
 
     MoveAllCreaturesInMoveList();
 
+    SendMonsterMoves();
+
     if (!m_mapRefManager.isEmpty() || !m_activeNonPlayers.empty())
         ProcessRelocationNotifies(t_diff);
 
+    if (!Instanceable() && sWorld->getIntConfig(CONFIG_VISIBILITY_CROWD_PLAYERS))
+        UpdateCrowdVisibility(t_diff);
+
     sScriptMgr->OnMapUpdate(this, t_diff);
 }
 
+#define CROWD_CHECK_INTERVAL    (10 * IN_MILLISECONDS)
+#define CROWD_MAX_NOTIFY_SCALE  4
+
+void Map::UpdateCrowdVisibility(const uint32 diff)
+{
+    if (m_crowdCheckTimer > diff)
+    {
+        m_crowdCheckTimer -= diff;
+        return;
+    }
+
+    m_crowdCheckTimer = CROWD_CHECK_INTERVAL;
+
+    // players in the most crowded cell
+    UNORDERED_MAP<uint32, uint32> cellPlayers;
+    uint32 crowd = 0;
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* player = itr->getSource();
+        uint32 count = ++cellPlayers[SkyFire::ComputeCellCoord(player->GetPositionX(), player->GetPositionY()).GetId()];
+        if (count > crowd)
+            crowd = count;
+    }
+
+    uint32 threshold = sWorld->getIntConfig(CONFIG_VISIBILITY_CROWD_PLAYERS);
+    float distance = World::GetMaxVisibleDistanceOnContinents();
+    int32 period = World::GetVisibilityNotifyPeriodOnContinents();
+    if (crowd > threshold)
+    {
+        // the observers of an object grow with the square of the distance, so the distance scales with the root of the crowd
+        // a minimum distance configured above the continent distance must not widen visibility
+        distance = std::min(distance, std::max(sWorld->getFloatConfig(CONFIG_VISIBILITY_CROWD_MIN_DISTANCE), distance * sqrt(float(threshold) / float(crowd))));
+        period = period * int32(std::min<uint32>(crowd / threshold, CROWD_MAX_NOTIFY_SCALE));
+    }
+
+    // keeps following the crowd when the distance is already pinned at its minimum
+    if (period != m_VisibilityNotifyPeriod)
+    {
+        sLog->outDebug(LOG_FILTER_MAPS, "Map %u: %u players in the most crowded cell, notify period %i -> %i ms",
+            GetId(), crowd, m_VisibilityNotifyPeriod, period);
+        m_VisibilityNotifyPeriod = period;
+    }
+
+    // ignore small changes so a crowd moving around the threshold doesn't trigger visibility updates all the time,
+    // but always get back to the configured distance once the crowd is gone
+    if (distance == m_VisibleDistance || (fabs(distance - m_VisibleDistance) < 5.0f && distance != World::GetMaxVisibleDistanceOnContinents()))
+        return;
+
+    sLog->outDebug(LOG_FILTER_MAPS, "Map %u: %u players in the most crowded cell, visibility distance %.1f -> %.1f",
+        GetId(), crowd, m_VisibleDistance, distance);
+
+    m_VisibleDistance = distance;
+
+    // let every player see or lose the objects between both distances
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+        itr->getSource()->AddToNotify(NOTIFY_VISIBILITY_CHANGED);
+}
+
 struct ResetNotifier
 {
     template<class T>inline void resetNotify(GridRefManager<T> &m)
@@ -679,6 +798,7 @@ void Map::ProcessRelocationNotifies(const uint32 diff)
 
 void Map::RemovePlayerFromMap(Player* player, bool remove)
 {
+    sMapCapture->OnPlayerRemoved(this, player);
     player->RemoveFromWorld();
     SendRemoveTransports(player);
 
@@ -723,6 +843,9 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
     Cell old_cell(player->GetPositionX(), player->GetPositionY());
     Cell new_cell(x, y);
 
+    if (!Instanceable() && sGridMapPrefetcher->IsActive())
+        PrefetchGridAhead(player, x, y);
+
     player->Relocate(x, y, z, orientation);
     if (player->IsVehicle())
         player->GetVehicleKit()->RelocatePassengers(x, y, z, orientation);
@@ -742,6 +865,128 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
     player->UpdateObjectVisibility(false);
 }
 
+void Map::PrefetchGridAhead(Player* player, float x, float y)
+{
+    float dx = x - player->GetPositionX();
+    float dy = y - player->GetPositionY();
+    float dist = sqrt(dx * dx + dy * dy);
+    // standing still or teleported
+    if (dist < 0.1f || dist > SIZE_OF_GRIDS)
+        return;
+
+    // where the player is after GRID_PREFETCH_LOOKAHEAD seconds in the same direction
+    float speed = player->GetSpeed((player->IsFlying() || player->isInFlight()) ? MOVE_FLIGHT : MOVE_RUN);
+    float aheadX = x + dx / dist * speed * GRID_PREFETCH_LOOKAHEAD;
+    float aheadY = y + dy / dist * speed * GRID_PREFETCH_LOOKAHEAD;
+    if (!SkyFire::IsValidMapCoord(aheadX, aheadY))
+        return;
+
+    GridCoord ahead = SkyFire::ComputeGridCoord(aheadX, aheadY);
+    if (ahead == SkyFire::ComputeGridCoord(x, y))
+        return;
+
+    int gx = (MAX_NUMBER_OF_GRIDS - 1) - ahead.x_coord;
+    int gy = (MAX_NUMBER_OF_GRIDS - 1) - ahead.y_coord;
+    if (!GridMaps[gx][gy])
+        sGridMapPrefetcher->Request(GetId(), gx, gy);
+}
+
+void Map::SendMonsterMove(Unit* mover, WorldPacket* data)
+{
+    // players see their own splines at once
+    if (!m_monsterMoveBatching || mover->GetTypeId() != TYPEID_UNIT)
+    {
+        mover->SendMessageToSet(data, true);
+        return;
+    }
+
+    PendingMonsterMove move;
+    move.guid = mover->GetGUID();
+    move.offset = uint32(m_monsterMoveData.size());
+    move.size = uint32(data->size());
+    m_monsterMoveData.insert(m_monsterMoveData.end(), data->contents(), data->contents() + data->size());
+
+    // a spline launched later in the same update replaces the previous one of the creature
+    std::pair<UNORDERED_MAP<uint64, uint32>::iterator, bool> itr = m_monsterMoveIndex.insert(std::make_pair(move.guid, uint32(m_monsterMoves.size())));
+    if (itr.second)
+        m_monsterMoves.push_back(move);
+    else
+        m_monsterMoves[itr.first->second] = move;
+}
+
+struct MonsterMoveCellOrderPred
+{
+    bool operator()(std::pair<uint32, SkyFire::MonsterMove> const& left, std::pair<uint32, SkyFire::MonsterMove> const& right) const
+    {
+        return left.first < right.first;
+    }
+};
+
+void Map::SendMonsterMoves()
+{
+    m_monsterMoveBatching = false;
+
+    if (m_monsterMoves.empty())
+        return;
+
+    // packets are built once, every observer of a mover gets the same one
+    std::vector<WorldPacket, TickArenaAllocator<WorldPacket> > packets;
+    packets.reserve(m_monsterMoves.size());
+    for (std::vector<PendingMonsterMove>::const_iterator itr = m_monsterMoves.begin(); itr != m_monsterMoves.end(); ++itr)
+    {
+        packets.push_back(WorldPacket(SMSG_MONSTER_MOVE, itr->size));
+        packets.back().append(&m_monsterMoveData[itr->offset], itr->size);
+    }
+
+    typedef std::pair<uint32, SkyFire::MonsterMove> CellMonsterMove;
+    std::vector<CellMonsterMove, TickArenaAllocator<CellMonsterMove> > moves;
+    moves.reserve(m_monsterMoves.size());
+    for (uint32 i = 0; i < m_monsterMoves.size(); ++i)
+    {
+        // pets are only in the Pet store, GetCreature would miss them
+        Unit* mover = ObjectAccessor::GetObjectInMap(m_monsterMoves[i].guid, this, (Unit*)NULL);
+        if (!mover || !mover->IsInWorld())
+            continue;
+
+        float range = mover->GetVisibilityRange();
+        SkyFire::MonsterMove move = { mover, &packets[i], range * range };
+        moves.push_back(CellMonsterMove(SkyFire::ComputeCellCoord(mover->GetPositionX(), mover->GetPositionY()).GetId(), move));
+    }
+
+    std::stable_sort(moves.begin(), moves.end(), MonsterMoveCellOrderPred());
+
+    std::vector<SkyFire::MonsterMove, TickArenaAllocator<SkyFire::MonsterMove> > group;
+    for (uint32 first = 0; first < moves.size();)
+    {
+        uint32 last = first;
+        float x = 0.0f, y = 0.0f;
+        group.clear();
+        for (; last < moves.size() && moves[last].first == moves[first].first; ++last)
+        {
+            group.push_back(moves[last].second);
+            x += moves[last].second.mover->GetPositionX();
+            y += moves[last].second.mover->GetPositionY();
+        }
+
+        x /= group.size();
+        y /= group.size();
+
+        // one visit around the center of the group reaching every observer of each member
+        float radius = 0.0f;
+        for (uint32 i = 0; i < group.size(); ++i)
+            radius = std::max(radius, group[i].mover->GetExactDist2d(x, y) + sqrt(group[i].distSq));
+
+        SkyFire::MonsterMoveDeliverer deliverer(&group[0], &group[0] + group.size());
+        VisitWorld(x, y, radius, deliverer);
+
+        first = last;
+    }
+
+    m_monsterMoves.clear();
+    m_monsterMoveIndex.clear();
+    m_monsterMoveData.clear();
+}
+
 void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang, bool respawnRelocationOnFail)
 {
     ASSERT(CheckGridIntegrity(creature, false));
@@ -33,6 +33,7 @@
 #include "SharedDefines.h"
 #include "GridRefManager.h"
 #include "MapRefManager.h"
+#include "TickArena.h"
 #include "DetourNavMesh.h"
 
 #include <ace/RW_Thread_Mutex.h>
@@ -233,9 +234,31 @@ enum LevelRequirementVsMode
 #define MAX_FALL_DISTANCE     250000.0f                     // "unlimited fall" to find VMap ground if it is available, just larger than MAX_HEIGHT - INVALID_HEIGHT
 #define DEFAULT_HEIGHT_SEARCH     50.0f                     // default search distance to find height at nearby locations
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
+#define GRID_PREFETCH_LOOKAHEAD 10.0f                       // seconds of movement ahead of a player whose grid is prefetched
 
 typedef std::map<uint32/*leaderDBGUID*/, CreatureGroup*>        CreatureGroupHolderType;
 
+#define MAP_UPDATE_TIME_BUCKETS 8
+
+// Duration histogram of the updates of one map, written only by the thread updating it
+struct MapUpdateStats
+{
+    MapUpdateStats();
+    void Add(uint32 duration);
+
+    // upper bound in ms of every bucket, the last one takes everything above
+    static uint32 const BucketLimits[MAP_UPDATE_TIME_BUCKETS];
+
+    uint32 buckets[MAP_UPDATE_TIME_BUCKETS];
+    uint32 count;
+    uint32 last;
+    uint32 max;
+    uint64 total;
+
+    uint32 visibilityNotifies;                              // player visibility updates done by the last update
+    uint32 visibilityObjects;                               // objects they had to check
+};
+
 class Map : public GridRefManager<NGridType>
 {
     friend class MapReference;
@@ -267,6 +290,8 @@ class Map : public GridRefManager<NGridType>
         virtual void InitVisibilityDistance();
 
         void PlayerRelocation(Player*, float x, float y, float z, float orientation);
+        // SMSG_MONSTER_MOVE of a launched spline; creature moves of the running Update() are queued and sent by SendMonsterMoves
+        void SendMonsterMove(Unit* mover, WorldPacket* data);
         void CreatureRelocation(Creature* creature, float x, float y, float z, float ang, bool respawnRelocationOnFail = true);
 
         template<class T, class CONTAINER> void Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER> &visitor);
@@ -350,6 +375,12 @@ class Map : public GridRefManager<NGridType>
         bool CheckGridIntegrity(Creature* c, bool moved) const;
 
         uint32 GetInstanceId() const { return i_InstanceId; }
+
+        // runs Update() and records its duration
+        void TimedUpdate(const uint32 diff);
+        MapUpdateStats const& GetUpdateStats() const { return m_updateStats; }
+        void AddVisibilityWork(uint32 objects) { ++m_visibilityNotifies; m_visibilityObjects += objects; }
+
         uint8 GetSpawnMode() const { return (i_spawnMode); }
         virtual bool CanEnter(Player* /*player*/) { return true; }
         const char* GetMapName() const;
@@ -444,6 +475,8 @@ class Map : public GridRefManager<NGridType>
 
         // Load MMap Data
         void LoadMMap(int gx, int gy);
+        // queues the grid a player moving to (x, y) is heading to for background loading
+        void PrefetchGridAhead(Player* player, float x, float y);
         void SetTimer(uint32 t) { i_gridExpiry = t < MIN_GRID_DELAY ? MIN_GRID_DELAY : t; }
 
         void SendInitSelf(Player* player);
@@ -527,6 +560,10 @@ class Map : public GridRefManager<NGridType>
         //visibility calculations. Highly optimized for massive calculations
         void ProcessRelocationNotifies(const uint32 diff);
 
+        // shrinks the visibility distance of crowded continents, see Visibility.Crowd.Players
+        void UpdateCrowdVisibility(const uint32 diff);
+        uint32 m_crowdCheckTimer;
+
         bool i_scriptLock;
         std::set<WorldObject*> i_objectsToRemove;
         std::map<WorldObject*, bool> i_objectsToSwitch;
@@ -535,6 +572,28 @@ class Map : public GridRefManager<NGridType>
         typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
         ScriptScheduleMap m_scriptSchedule;
 
+        // transient containers of the running Update(), see TickArenaAllocator
+        TickArena _tickArena;
+
+        MapUpdateStats m_updateStats;
+        uint32 m_visibilityNotifies;
+        uint32 m_visibilityObjects;
+
+        // delivers the queued monster moves, one grid visit per group of creatures sharing a cell
+        void SendMonsterMoves();
+
+        struct PendingMonsterMove
+        {
+            uint64 guid;
+            uint32 offset;                                  // of the packet data in m_monsterMoveData
+            uint32 size;
+        };
+
+        bool m_monsterMoveBatching;
+        std::vector<PendingMonsterMove> m_monsterMoves;
+        UNORDERED_MAP<uint64, uint32> m_monsterMoveIndex;   // mover guid -> index in m_monsterMoves
+        std::vector<uint8> m_monsterMoveData;
+
         // Type specific code for add/remove to/from grid
         template<class T>
             void AddToGrid(T* object, Cell const& cell);
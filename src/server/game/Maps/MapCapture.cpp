@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapCapture.h"
+#include "DBCStores.h"
+#include "Map.h"
+#include "MapManager.h"
+#include "ObjectMgr.h"
+#include "Player.h"
+#include "WorldPacket.h"
+#include "WorldSession.h"
+#include "Util.h"
+
+#include <ace/Guard_T.h>
+
+static const char MapCaptureMagic[4] = { 'M', 'C', 'A', 'P' };
+
+MapCapture::MapCapture() : m_capturing(false), m_pending(false), m_stopRequested(false), m_replaying(false),
+    m_mapId(0), m_seed(0), m_tick(0), m_duration(0)
+{
+}
+
+bool MapCapture::Start(uint32 mapId, uint32 duration, std::string const& fileName)
+{
+    if (m_capturing || m_pending || m_replaying)
+        return false;
+
+    // instances are created per group, a replay could not recreate the same one
+    MapEntry const* entry = sMapStore.LookupEntry(mapId);
+    if (!entry || entry->Instanceable())
+        return false;
+
+    m_mapId = mapId;
+    m_duration = duration;
+    m_fileName = fileName;
+    m_stopRequested = false;
+    m_pending = true;
+    return true;
+}
+
+void MapCapture::Stop()
+{
+    m_pending = false;
+    m_stopRequested = true;
+}
+
+void MapCapture::Update(uint32 diff)
+{
+    if (m_replaying)
+    {
+        ReseedRandom(GetTickSeed());
+        return;
+    }
+
+    if (m_pending)
+        Begin();
+
+    if (!m_capturing)
+        return;
+
+    if (m_stopRequested || !m_duration)
+    {
+        Finish();
+        return;
+    }
+
+    m_duration -= std::min(diff, m_duration);
+    ++m_tick;
+
+    {
+        SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+        m_data << uint8(MAP_CAPTURE_TICK);
+        m_data << uint32(diff);
+    }
+
+    ReseedRandom(GetTickSeed());
+}
+
+void MapCapture::OnMapUpdate(Map* map)
+{
+    if ((m_capturing || m_replaying) && map->GetId() == m_mapId && !map->GetInstanceId())
+        ReseedRandom(GetTickSeed() ^ 0x9E3779B9);
+}
+
+void MapCapture::OnPlayerAdded(Map* map, Player* player)
+{
+    if (!m_capturing || map->GetId() != m_mapId)
+        return;
+
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    WriteJoin(player);
+}
+
+void MapCapture::OnPlayerRemoved(Map* map, Player* player)
+{
+    if (!m_capturing || map->GetId() != m_mapId)
+        return;
+
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    m_data << uint8(MAP_CAPTURE_LEAVE);
+    m_data << uint32(player->GetSession()->GetAccountId());
+}
+
+void MapCapture::RecordPacket(WorldSession* session, WorldPacket const& packet)
+{
+    Player* player = session->GetPlayer();
+    if (!player || !player->IsInWorld() || player->GetMapId() != m_mapId)
+        return;
+
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    m_data << uint8(MAP_CAPTURE_PACKET);
+    m_data << uint32(session->GetAccountId());
+    m_data << uint32(packet.GetOpcode());
+    m_data << uint32(packet.size());
+    if (!packet.empty())
+        m_data.append(packet.contents(), packet.size());
+}
+
+void MapCapture::StartReplay(uint32 mapId, uint32 seed)
+{
+    m_mapId = mapId;
+    m_seed = seed;
+    m_tick = 0;
+    m_replaying = true;
+}
+
+void MapCapture::StopReplay()
+{
+    m_replaying = false;
+}
+
+void MapCapture::Begin()
+{
+    m_pending = false;
+    m_seed = uint32(rand32());
+    m_tick = 0;
+
+    m_data.clear();
+    m_data.append(MapCaptureMagic, sizeof(MapCaptureMagic));
+    m_data << uint32(MAP_CAPTURE_VERSION);
+    m_data << uint32(m_mapId);
+    m_data << uint32(m_seed);
+    m_data << uint64(time(NULL));
+
+    WriteSpawns();
+
+    // players already on the map join before the first tick
+    uint32 players = 0;
+    if (Map* map = sMapMgr->FindMap(m_mapId, 0))
+    {
+        for (Map::PlayerList::const_iterator itr = map->GetPlayers().begin(); itr != map->GetPlayers().end(); ++itr)
+        {
+            if (Player* player = itr->getSource())
+            {
+                WriteJoin(player);
+                ++players;
+            }
+        }
+    }
+
+    m_capturing = true;
+    sLog->outString("MapCapture: capturing map %u with %u players for %u ms into '%s'.", m_mapId, players, m_duration, m_fileName.c_str());
+}
+
+void MapCapture::Finish()
+{
+    m_capturing = false;
+    m_stopRequested = false;
+
+    // write to a temporary file first so a replay never reads a half written capture
+    std::string tmpFileName = m_fileName + ".tmp";
+    FILE* file = fopen(tmpFileName.c_str(), "wb");
+    bool ok = file && fwrite(m_data.contents(), m_data.size(), 1, file) == 1;
+    if (file)
+        ok = fclose(file) == 0 && ok;
+
+    if (ok)
+    {
+        remove(m_fileName.c_str());
+        ok = rename(tmpFileName.c_str(), m_fileName.c_str()) == 0;
+    }
+
+    if (ok)
+        sLog->outString("MapCapture: written %u ticks (%u bytes) of map %u to '%s'.", m_tick, uint32(m_data.size()), m_mapId, m_fileName.c_str());
+    else
+    {
+        sLog->outError("MapCapture: failed to write '%s'.", m_fileName.c_str());
+        remove(tmpFileName.c_str());
+    }
+
+    m_data.clear();
+}
+
+void MapCapture::WriteJoin(Player* player)
+{
+    WorldSession* session = player->GetSession();
+    m_data << uint8(MAP_CAPTURE_JOIN);
+    m_data << uint32(session->GetAccountId());
+    m_data << uint8(session->GetSecurity());
+    m_data << uint8(session->Expansion());
+    m_data << uint8(session->GetSessionDbcLocale());
+    m_data << uint64(player->GetGUID());
+    m_data << player->GetPositionX() << player->GetPositionY() << player->GetPositionZ() << player->GetOrientation();
+}
+
+void MapCapture::WriteSpawns()
+{
+    CellObjectGuidsMap const& cells = sObjectMgr->GetMapObjectGuids(m_mapId, REGULAR_DIFFICULTY);
+
+    uint32 count = 0;
+    size_t countPos = m_data.wpos();
+    m_data << uint32(0);
+
+    for (CellObjectGuidsMap::const_iterator cell = cells.begin(); cell != cells.end(); ++cell)
+    {
+        for (CellGuidSet::const_iterator itr = cell->second.creatures.begin(); itr != cell->second.creatures.end(); ++itr)
+        {
+            if (CreatureData const* data = sObjectMgr->GetCreatureData(*itr))
+            {
+                m_data << uint8(MAP_CAPTURE_CREATURE) << uint32(*itr) << uint32(data->id);
+                m_data << data->posX << data->posY << data->posZ;
+                ++count;
+            }
+        }
+
+        for (CellGuidSet::const_iterator itr = cell->second.gameobjects.begin(); itr != cell->second.gameobjects.end(); ++itr)
+        {
+            if (GameObjectData const* data = sObjectMgr->GetGOData(*itr))
+            {
+                m_data << uint8(MAP_CAPTURE_GAMEOBJECT) << uint32(*itr) << uint32(data->id);
+                m_data << data->posX << data->posY << data->posZ;
+                ++count;
+            }
+        }
+    }
+
+    m_data.put<uint32>(countPos, count);
+}
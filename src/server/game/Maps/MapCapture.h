@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MAP_CAPTURE_H
+#define _MAP_CAPTURE_H
+
+#include "Common.h"
+#include "ByteBuffer.h"
+
+#include <ace/Singleton.h>
+#include <ace/Thread_Mutex.h>
+
+// Bump when the layout of the file or of an event changes
+#define MAP_CAPTURE_VERSION 1
+
+class Map;
+class Player;
+class WorldPacket;
+class WorldSession;
+
+enum MapCaptureEvent
+{
+    MAP_CAPTURE_TICK        = 0,                            // diff; following events belong to this world tick
+    MAP_CAPTURE_JOIN        = 1,                            // a player entered the map, or was on it at the start
+    MAP_CAPTURE_LEAVE       = 2,                            // a player left the map
+    MAP_CAPTURE_PACKET      = 3                             // a packet handled for a player on the map
+};
+
+enum MapCaptureSpawnType
+{
+    MAP_CAPTURE_CREATURE    = 0,
+    MAP_CAPTURE_GAMEOBJECT  = 1
+};
+
+/*
+ * Records what drives the updates of one continent for a while: the world
+ * tick diffs, the packets handled for the players on it and the players
+ * entering and leaving it, plus the database spawns of the map so a replay
+ * can tell whether it runs against the same world data. See MapReplay.
+ *
+ * While a capture or replay runs the random generator of the world thread is
+ * reseeded at the start of every world tick, and the one of the thread
+ * updating the map at the start of every map update, from the capture seed
+ * and the tick number, so both runs draw the same numbers.
+ *
+ * The file is built in memory and written when the capture ends.
+ */
+class MapCapture
+{
+    friend class ACE_Singleton<MapCapture, ACE_Null_Mutex>;
+
+    public:
+        // captures the continent for duration milliseconds of game time, starting with the next world tick
+        bool Start(uint32 mapId, uint32 duration, std::string const& fileName);
+        // ends the running capture with the next world tick
+        void Stop();
+
+        bool IsCapturing() const { return m_capturing; }
+        bool IsPending() const { return m_pending; }
+        uint32 GetMapId() const { return m_mapId; }
+        uint32 GetTick() const { return m_tick; }
+
+        // start of a world tick, called by World::Update
+        void Update(uint32 diff);
+        // start of an update of a map, called by Map::TimedUpdate
+        void OnMapUpdate(Map* map);
+        void OnPlayerAdded(Map* map, Player* player);
+        void OnPlayerRemoved(Map* map, Player* player);
+        // before the handler of a packet runs, only called while IsCapturing()
+        void RecordPacket(WorldSession* session, WorldPacket const& packet);
+
+        // the replay drives the ticks itself, Update() then only reseeds
+        void StartReplay(uint32 mapId, uint32 seed);
+        void SetReplayTick(uint32 tick) { m_tick = tick; }
+        void StopReplay();
+
+    private:
+        MapCapture();
+        ~MapCapture() {}
+
+        void Begin();
+        void Finish();
+        void WriteJoin(Player* player);
+        void WriteSpawns();
+
+        uint32 GetTickSeed() const { return m_seed + m_tick * 2654435761U; }
+
+        bool volatile m_capturing;
+        bool m_pending;                                     // Start() was called, waiting for the next tick
+        bool m_stopRequested;
+        bool m_replaying;
+
+        uint32 m_mapId;
+        uint32 m_seed;
+        uint32 m_tick;
+        uint32 m_duration;                                  // game time still to capture
+        std::string m_fileName;
+
+        ACE_Thread_Mutex m_lock;                            // protects m_data, written by the world and map threads
+        ByteBuffer m_data;
+};
+
+#define sMapCapture ACE_Singleton<MapCapture, ACE_Null_Mutex>::instance()
+
+#endif
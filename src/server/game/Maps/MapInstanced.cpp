@@ -51,7 +51,7 @@ void MapInstanced::Update(const uint32 t)
     // take care of loaded GridMaps (when unused, unload it!)
     Map::Update(t);
 
-    // update the instanced maps
+    // the instances left are updated by MapManager::Update together with all other maps
     InstancedMaps::iterator i = m_InstancedMaps.begin();
 
     while (i != m_InstancedMaps.end())
@@ -64,14 +64,7 @@ void MapInstanced::Update(const uint32 t)
             }
         }
         else
-        {
-            // update only here, because it may schedule some bad things before delete
-            if (sMapMgr->GetMapUpdater()->activated())
-                sMapMgr->GetMapUpdater()->schedule_update(*i->second, t);
-            else
-                i->second->Update(t);
             ++i;
-        }
     }
 }
 
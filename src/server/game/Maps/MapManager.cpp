@@ -25,6 +25,7 @@
 #include "Transport.h"
 #include "GridDefines.h"
 #include "MapInstanced.h"
+#include "GridMapPrefetcher.h"
 #include "InstanceScript.h"
 #include "Config.h"
 #include "World.h"
@@ -62,6 +63,9 @@ void MapManager::Initialize()
     // Start mtmaps if needed.
     if (num_threads > 0 && m_updater.activate(num_threads) == -1)
         abort();
+
+    if (sWorld->getBoolConfig(CONFIG_GRID_PREFETCH))
+        sGridMapPrefetcher->Activate();
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -272,20 +276,35 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
+    std::vector<Map*> maps;
+    maps.reserve(i_maps.size());
+
     MapMapType::iterator iter = i_maps.begin();
     for (; iter != i_maps.end(); ++iter)
     {
-        if (m_updater.activated())
-            m_updater.schedule_update(*iter->second, uint32(i_timer.GetCurrent()));
-        else
-            iter->second->Update(uint32(i_timer.GetCurrent()));
+        MapInstanced* instanced = iter->second->ToMapInstanced();
+        if (!instanced)
+        {
+            maps.push_back(iter->second);
+            continue;
+        }
+
+        // the parent unloads its idle instances here, before any of them is scheduled,
+        // the remaining instances are ordered by their update time with all other maps
+        instanced->TimedUpdate(uint32(i_timer.GetCurrent()));
+        for (MapInstanced::InstancedMaps::iterator itr = instanced->GetInstancedMaps().begin(); itr != instanced->GetInstancedMaps().end(); ++itr)
+            maps.push_back(itr->second);
     }
+
+    m_updater.schedule_updates(maps, uint32(i_timer.GetCurrent()));
     if (m_updater.activated())
         m_updater.wait();
 
     for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
 
+    sGridMapPrefetcher->Update();
+
     sObjectAccessor->Update(uint32(i_timer.GetCurrent()));
     for (TransportSet::iterator itr = m_Transports.begin(); itr != m_Transports.end(); ++itr)
         (*itr)->Update(uint32(i_timer.GetCurrent()));
@@ -293,6 +312,18 @@ void MapManager::Update(uint32 diff)
     i_timer.SetCurrent(0);
 }
 
+void MapManager::GetAllMaps(std::vector<Map*>& maps)
+{
+    for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+    {
+        maps.push_back(iter->second);
+
+        if (MapInstanced* instanced = iter->second->ToMapInstanced())
+            for (MapInstanced::InstancedMaps::iterator itr = instanced->GetInstancedMaps().begin(); itr != instanced->GetInstancedMaps().end(); ++itr)
+                maps.push_back(itr->second);
+    }
+}
+
 void MapManager::DoDelayedMovesAndRemoves()
 {
 }
@@ -337,6 +368,8 @@ void MapManager::UnloadAll()
     if (m_updater.activated())
         m_updater.deactivate();
 
+    sGridMapPrefetcher->Deactivate();
+
     Map::DeleteStateMachine();
 }
 
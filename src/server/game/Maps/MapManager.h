@@ -149,6 +149,9 @@ class MapManager
 
         MapUpdater * GetMapUpdater() { return &m_updater; }
 
+        // every loaded map including instances, only safe to use while the maps are not updating
+        void GetAllMaps(std::vector<Map*>& maps);
+
     private:
         typedef UNORDERED_MAP<uint32, Map*> MapMapType;
         typedef std::vector<bool> InstanceIds;
@@ -0,0 +1,508 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapReplay.h"
+#include "MapCapture.h"
+#include "Config.h"
+#include "DatabaseEnv.h"
+#include "Map.h"
+#include "MapManager.h"
+#include "ObjectMgr.h"
+#include "ObjectPool.h"
+#include "Opcodes.h"
+#include "Player.h"
+#include "Timer.h"
+#include "World.h"
+#include "WorldPacket.h"
+#include "WorldSession.h"
+
+#define REPLAY_LOGIN_TIMEOUT    (30 * IN_MILLISECONDS)
+// a spawn further away than this from its captured position counts as moved
+#define REPLAY_SPAWN_TOLERANCE  1.0f
+#define REPLAY_TOP_ENTRIES      15
+
+MapReplay::MapReplay() : m_mapId(0), m_seed(0), m_spawns(0), m_spawnMismatches(0), m_joins(0), m_failedLogins(0)
+{
+}
+
+static bool IsCharacterListed(WorldSession* session, uint32 lowGuid)
+{
+    return session->CharCanLogin(lowGuid);
+}
+
+static bool IsCharacterInWorld(WorldSession* session, uint32 lowGuid)
+{
+    Player* player = session->GetPlayer();
+    return player && player->GetGUIDLow() == lowGuid && player->IsInWorld() && !session->PlayerLoading();
+}
+
+// the login queries run on the database workers, the world stands still until they are back
+static bool UpdateWorldUntil(WorldSession* session, uint32 lowGuid, bool (*done)(WorldSession*, uint32))
+{
+    uint32 start = getMSTime();
+    do
+    {
+        sWorld->Update(0);
+        if (done(session, lowGuid))
+            return true;
+
+        ACE_Based::Thread::Sleep(1);
+    }
+    while (GetMSTimeDiffToNow(start) < REPLAY_LOGIN_TIMEOUT);
+
+    return false;
+}
+
+bool MapReplay::Run(std::string const& fileName)
+{
+    if (!Load(fileName))
+        return false;
+
+    try
+    {
+        CheckSpawns();
+    }
+    catch (ByteBufferException &)
+    {
+        sLog->outError("MapReplay: '%s' is truncated.", fileName.c_str());
+        return false;
+    }
+
+    sLog->outString("MapReplay: replaying map %u from '%s', %u of %u captured spawns are missing or moved in this world database.",
+        m_mapId, fileName.c_str(), m_spawnMismatches, m_spawns);
+
+    sMapCapture->StartReplay(m_mapId, m_seed);
+    Profiler::Reset();
+
+    std::vector<ObjectPool*> const& pools = ObjectPool::GetPools();
+    for (std::vector<ObjectPool*>::const_iterator itr = pools.begin(); itr != pools.end(); ++itr)
+    {
+        ObjectPool::Stats stats;
+        (*itr)->GetStats(stats);
+        m_poolAllocations.push_back(stats.allocations);
+    }
+
+    // the events after a tick are those handled during it, so they are applied before running it
+    bool tickPending = false;
+    uint32 pendingDiff = 0;
+    try
+    {
+        while (m_data.rpos() < m_data.size() && !World::IsStopped())
+        {
+            switch (m_data.read<uint8>())
+            {
+                case MAP_CAPTURE_TICK:
+                    if (tickPending)
+                        RunTick(pendingDiff);
+                    m_data >> pendingDiff;
+                    tickPending = true;
+                    break;
+                case MAP_CAPTURE_JOIN:
+                    Join();
+                    break;
+                case MAP_CAPTURE_LEAVE:
+                    Leave();
+                    break;
+                case MAP_CAPTURE_PACKET:
+                    ReadPacket();
+                    break;
+                default:
+                    sLog->outError("MapReplay: unknown event at offset %u of '%s', replay stopped.", uint32(m_data.rpos() - 1), fileName.c_str());
+                    m_data.rpos(m_data.size());
+                    break;
+            }
+        }
+
+        if (tickPending)
+            RunTick(pendingDiff);
+    }
+    catch (ByteBufferException &)
+    {
+        sLog->outError("MapReplay: '%s' is truncated, replayed %u ticks.", fileName.c_str(), uint32(m_ticks.size()));
+    }
+
+    LogoutAll();
+    sMapCapture->StopReplay();
+
+    Profiler::EntryMap entries;
+    Profiler::Collect(entries);
+    WriteReport(fileName, entries);
+    LogSummary(entries);
+
+    // without a single player in world the report only measured an empty map
+    if (m_joins && m_failedLogins == m_joins)
+    {
+        sLog->outError("MapReplay: none of the %u captured logins reached the world.", m_joins);
+        return false;
+    }
+
+    return true;
+}
+
+bool MapReplay::Load(std::string const& fileName)
+{
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+    {
+        sLog->outError("MapReplay: can't open '%s'.", fileName.c_str());
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    std::vector<uint8> buffer(size > 0 ? size_t(size) : 0);
+    bool ok = !buffer.empty() && fread(&buffer[0], buffer.size(), 1, file) == 1;
+    fclose(file);
+
+    char magic[4];
+    uint32 version = 0;
+    uint64 captureTime = 0;
+    if (ok && buffer.size() >= sizeof(magic) + 3 * sizeof(uint32) + sizeof(uint64))
+    {
+        m_data.clear();
+        m_data.append(&buffer[0], buffer.size());
+        m_data.read((uint8*)magic, sizeof(magic));
+        m_data >> version >> m_mapId >> m_seed >> captureTime;
+    }
+    else
+        ok = false;
+
+    if (!ok || memcmp(magic, "MCAP", sizeof(magic)) != 0)
+    {
+        sLog->outError("MapReplay: '%s' is not a map capture.", fileName.c_str());
+        return false;
+    }
+
+    if (version != MAP_CAPTURE_VERSION)
+    {
+        sLog->outError("MapReplay: '%s' has version %u, this server reads version %u.", fileName.c_str(), version, MAP_CAPTURE_VERSION);
+        return false;
+    }
+
+    return true;
+}
+
+void MapReplay::CheckSpawns()
+{
+    m_data >> m_spawns;
+    for (uint32 i = 0; i < m_spawns; ++i)
+    {
+        uint8 type;
+        uint32 guid, entry;
+        float x, y, z;
+        m_data >> type >> guid >> entry >> x >> y >> z;
+
+        bool found = false;
+        if (type == MAP_CAPTURE_CREATURE)
+        {
+            if (CreatureData const* data = sObjectMgr->GetCreatureData(guid))
+                found = data->id == entry && data->mapid == m_mapId && fabs(data->posX - x) <= REPLAY_SPAWN_TOLERANCE &&
+                    fabs(data->posY - y) <= REPLAY_SPAWN_TOLERANCE && fabs(data->posZ - z) <= REPLAY_SPAWN_TOLERANCE;
+        }
+        else if (GameObjectData const* data = sObjectMgr->GetGOData(guid))
+            found = data->id == entry && data->mapid == m_mapId && fabs(data->posX - x) <= REPLAY_SPAWN_TOLERANCE &&
+                fabs(data->posY - y) <= REPLAY_SPAWN_TOLERANCE && fabs(data->posZ - z) <= REPLAY_SPAWN_TOLERANCE;
+
+        if (!found)
+            ++m_spawnMismatches;
+    }
+}
+
+void MapReplay::Join()
+{
+    uint32 accountId;
+    uint8 security, expansion, locale;
+    uint64 guid;
+    float x, y, z, orientation;
+    m_data >> accountId >> security >> expansion >> locale >> guid >> x >> y >> z >> orientation;
+
+    WorldSession*& session = m_sessions[accountId];
+    if (!session)
+    {
+        session = new WorldSession(accountId, NULL, AccountTypes(security), expansion, 0, LocaleConstant(locale), 0, false);
+        session->SetReplaySession(true);
+        sWorld->AddSession(session);
+    }
+    else if (session->GetPlayer())
+        session->LogoutPlayer(false);
+
+    // the copied characters table holds where the player was at the last save, not where the capture saw it
+    CharacterDatabase.DirectPExecute("UPDATE characters SET map = %u, instance_id = 0, position_x = %f, position_y = %f, position_z = %f, orientation = %f WHERE guid = %u",
+        m_mapId, x, y, z, orientation, GUID_LOPART(guid));
+
+    ++m_joins;
+
+    // like a client, list the characters first: the login handler only accepts characters of the last enum
+    session->QueuePacket(new WorldPacket(CMSG_CHAR_ENUM, 0));
+    if (!UpdateWorldUntil(session, GUID_LOPART(guid), &IsCharacterListed))
+    {
+        sLog->outError("MapReplay: character %u is not on account %u in this characters database, its packets are dropped.", GUID_LOPART(guid), accountId);
+        ++m_failedLogins;
+        return;
+    }
+
+    WorldPacket* packet = new WorldPacket(CMSG_PLAYER_LOGIN, 8);
+    *packet << uint64(guid);
+    session->QueuePacket(packet);
+
+    if (!UpdateWorldUntil(session, GUID_LOPART(guid), &IsCharacterInWorld))
+    {
+        sLog->outError("MapReplay: account %u could not log in character %u, its packets are dropped.", accountId, GUID_LOPART(guid));
+        ++m_failedLogins;
+        return;
+    }
+
+    // e.g. sent to its homebind by a login check, the packets were captured on the replayed map
+    if (session->GetPlayer()->GetMapId() != m_mapId)
+    {
+        sLog->outError("MapReplay: character %u of account %u logged in on map %u instead of %u, its packets are dropped.",
+            GUID_LOPART(guid), accountId, session->GetPlayer()->GetMapId(), m_mapId);
+        session->LogoutPlayer(false);
+        ++m_failedLogins;
+    }
+}
+
+void MapReplay::Leave()
+{
+    uint32 accountId;
+    m_data >> accountId;
+
+    // may already be gone through a replayed logout
+    SessionMap::const_iterator itr = m_sessions.find(accountId);
+    if (itr != m_sessions.end() && itr->second->GetPlayer())
+        itr->second->LogoutPlayer(false);
+}
+
+// the logins of a tick run the world until the player is in, packets queued before would be handled outside of the tick
+void MapReplay::ReadPacket()
+{
+    uint32 accountId, opcode, size;
+    m_data >> accountId >> opcode >> size;
+
+    // a corrupt size must not allocate before the read fails
+    if (size > m_data.size() - m_data.rpos())
+        throw ByteBufferPositionException(false, m_data.rpos(), size, m_data.size());
+
+    std::vector<uint8> payload(size);
+    if (size)
+        m_data.read(&payload[0], size);
+
+    if (opcode >= NUM_MSG_TYPES)
+        return;
+
+    WorldPacket* packet = new WorldPacket(opcode, size);
+    if (size)
+        packet->append(&payload[0], size);
+
+    m_tickPackets.push_back(PacketList::value_type(accountId, packet));
+}
+
+void MapReplay::RunTick(uint32 diff)
+{
+    uint32 packets = 0;
+    for (PacketList::const_iterator itr = m_tickPackets.begin(); itr != m_tickPackets.end(); ++itr)
+    {
+        SessionMap::const_iterator session = m_sessions.find(itr->first);
+        if (session == m_sessions.end() || !session->second->GetPlayer())
+        {
+            delete itr->second;
+            continue;
+        }
+
+        session->second->QueuePacket(itr->second);
+        ++packets;
+    }
+
+    m_tickPackets.clear();
+
+    Map* map = sMapMgr->FindMap(m_mapId, 0);
+    uint32 mapUpdates = map ? map->GetUpdateStats().count : 0;
+    uint64 allocations = GetPoolAllocations();
+
+    sMapCapture->SetReplayTick(uint32(m_ticks.size() + 1));
+
+    ACE_Time_Value start = ACE_OS::gettimeofday();
+    sWorld->Update(diff);
+    ACE_UINT64 elapsed;
+    (ACE_OS::gettimeofday() - start).to_usec(elapsed);
+
+    Tick tick;
+    tick.diff = diff;
+    tick.worldTime = uint32(elapsed);
+
+    // the first login may have created the map during this tick
+    map = sMapMgr->FindMap(m_mapId, 0);
+    tick.mapUpdated = map && map->GetUpdateStats().count != mapUpdates;
+    tick.mapTime = tick.mapUpdated ? map->GetUpdateStats().last : 0;
+    tick.packets = packets;
+    tick.allocations = uint32(GetPoolAllocations() - allocations);
+    m_ticks.push_back(tick);
+}
+
+void MapReplay::LogoutAll()
+{
+    // left over by a truncated capture
+    for (PacketList::const_iterator itr = m_tickPackets.begin(); itr != m_tickPackets.end(); ++itr)
+        delete itr->second;
+
+    m_tickPackets.clear();
+
+    for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
+    {
+        if (itr->second->GetPlayer())
+            itr->second->LogoutPlayer(false);
+
+        // without the socket the world removes the session with its next update
+        itr->second->SetReplaySession(false);
+    }
+
+    m_sessions.clear();
+}
+
+void MapReplay::WriteReport(std::string const& captureFile, Profiler::EntryMap const& entries)
+{
+    std::string fileName = ConfigMgr::GetStringDefault("MapReplay.ReportFile", "replay.txt");
+    FILE* file = fopen(fileName.c_str(), "w");
+    if (!file)
+    {
+        sLog->outError("MapReplay: can't create '%s'.", fileName.c_str());
+        return;
+    }
+
+    // tab separated records like the profile dump, times in microseconds unless stated otherwise
+    fprintf(file, "replay\t%s\t%u\t%u\t%u\t%u\t%u\n", captureFile.c_str(), m_mapId, uint32(m_ticks.size()), m_spawns,
+        m_spawnMismatches, m_failedLogins);
+
+    // map update times are in milliseconds, "-" when the map was not updated in the tick
+    for (size_t i = 0; i < m_ticks.size(); ++i)
+    {
+        Tick const& tick = m_ticks[i];
+        if (tick.mapUpdated)
+            fprintf(file, "tick\t%u\t%u\t%u\t%u\t%u\t%u\n", uint32(i + 1), tick.diff, tick.worldTime, tick.mapTime, tick.packets, tick.allocations);
+        else
+            fprintf(file, "tick\t%u\t%u\t%u\t-\t%u\t%u\n", uint32(i + 1), tick.diff, tick.worldTime, tick.packets, tick.allocations);
+    }
+
+    for (Profiler::EntryMap::const_iterator itr = entries.begin(); itr != entries.end(); ++itr)
+    {
+        ProfileEntry const& entry = itr->second;
+        fprintf(file, "%s\t%u\t%s\t" UI64FMTD "\t" UI64FMTD "\t%u", Profiler::GetCategoryName(ProfileCategory(itr->first >> 32)),
+            uint32(itr->first), entry.name.c_str(), entry.count, entry.total, entry.max);
+        for (uint8 i = 0; i < PROFILE_TIME_BUCKETS; ++i)
+            fprintf(file, "\t%u", entry.buckets[i]);
+        fprintf(file, "\n");
+    }
+
+    // allocations made during the replay
+    std::vector<ObjectPool*> const& pools = ObjectPool::GetPools();
+    for (size_t i = 0; i < pools.size() && i < m_poolAllocations.size(); ++i)
+    {
+        ObjectPool::Stats stats;
+        pools[i]->GetStats(stats);
+        fprintf(file, "pool\t%s\t" UI64FMTD "\t" UI64FMTD "\n", pools[i]->GetName(), stats.allocations - m_poolAllocations[i], stats.live);
+    }
+
+    if (fclose(file) != 0)
+        sLog->outError("MapReplay: failed to write '%s'.", fileName.c_str());
+    else
+        sLog->outString("MapReplay: report written to '%s'.", fileName.c_str());
+}
+
+// costliest first
+struct ProfileEntryTotalOrderPred
+{
+    bool operator()(std::pair<uint64, ProfileEntry const*> const& left, std::pair<uint64, ProfileEntry const*> const& right) const
+    {
+        return left.second->total > right.second->total;
+    }
+};
+
+void MapReplay::LogSummary(Profiler::EntryMap const& entries)
+{
+    if (m_ticks.empty())
+    {
+        sLog->outString("MapReplay: no ticks replayed.");
+        return;
+    }
+
+    std::vector<uint32> worldTimes;
+    uint64 worldTotal = 0;
+    uint64 mapTotal = 0;
+    uint32 mapUpdates = 0;
+    uint32 mapMax = 0;
+    uint64 allocations = 0;
+    uint32 packets = 0;
+    for (std::vector<Tick>::const_iterator itr = m_ticks.begin(); itr != m_ticks.end(); ++itr)
+    {
+        worldTimes.push_back(itr->worldTime);
+        worldTotal += itr->worldTime;
+        allocations += itr->allocations;
+        packets += itr->packets;
+        if (itr->mapUpdated)
+        {
+            ++mapUpdates;
+            mapTotal += itr->mapTime;
+            mapMax = std::max(mapMax, itr->mapTime);
+        }
+    }
+
+    std::sort(worldTimes.begin(), worldTimes.end());
+    uint32 ticks = uint32(worldTimes.size());
+
+    sLog->outString("MapReplay: %u ticks, %u packets, %u of %u logins failed.", ticks, packets, m_failedLogins, m_joins);
+    sLog->outString("MapReplay: world update avg %u us, p50 %u us, p99 %u us, max %u us.", uint32(worldTotal / ticks),
+        worldTimes[ticks / 2], worldTimes[std::min(ticks - 1, ticks * 99 / 100)], worldTimes.back());
+    sLog->outString("MapReplay: %u map updates, avg %u ms, max %u ms.", mapUpdates, mapUpdates ? uint32(mapTotal / mapUpdates) : 0, mapMax);
+    sLog->outString("MapReplay: " UI64FMTD " object pool allocations, %.1f per tick.", allocations, float(allocations) / ticks);
+
+    std::vector<std::pair<uint64, ProfileEntry const*> > costliest;
+    for (Profiler::EntryMap::const_iterator itr = entries.begin(); itr != entries.end(); ++itr)
+    {
+        ProfileCategory category = ProfileCategory(itr->first >> 32);
+        if (category != PROFILE_PACKET_SIZE && category != PROFILE_PACKET_THROTTLED)
+            costliest.push_back(std::make_pair(itr->first, &itr->second));
+    }
+
+    std::sort(costliest.begin(), costliest.end(), ProfileEntryTotalOrderPred());
+    if (costliest.size() > REPLAY_TOP_ENTRIES)
+        costliest.resize(REPLAY_TOP_ENTRIES);
+
+    for (size_t i = 0; i < costliest.size(); ++i)
+    {
+        ProfileEntry const& entry = *costliest[i].second;
+        sLog->outString("MapReplay: %s %s: " UI64FMTD " calls, " UI64FMTD " us total, max %u us.",
+            Profiler::GetCategoryName(ProfileCategory(costliest[i].first >> 32)), entry.name.c_str(), entry.count, entry.total, entry.max);
+    }
+}
+
+uint64 MapReplay::GetPoolAllocations()
+{
+    uint64 allocations = 0;
+    std::vector<ObjectPool*> const& pools = ObjectPool::GetPools();
+    for (std::vector<ObjectPool*>::const_iterator itr = pools.begin(); itr != pools.end(); ++itr)
+    {
+        ObjectPool::Stats stats;
+        (*itr)->GetStats(stats);
+        allocations += stats.allocations;
+    }
+
+    return allocations;
+}
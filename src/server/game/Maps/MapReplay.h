@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MAP_REPLAY_H
+#define _MAP_REPLAY_H
+
+#include "Common.h"
+#include "ByteBuffer.h"
+#include "Profiler.h"
+
+#include <ace/Singleton.h>
+
+class WorldSession;
+class WorldPacket;
+
+/*
+ * Runs a MapCapture file through World::Update without any network: every
+ * captured player gets a socketless session and logs in at the captured
+ * position, the captured packets are queued at the start of the tick they
+ * were handled in, after its joins and leaves, and the world ticks with the
+ * captured diffs as fast as it can.
+ *
+ * Meant for a worldserver started with --replay on a copy of the databases:
+ * joining players are moved in the characters table before they log in and
+ * leaving players are not saved.
+ * Time spent waiting for the database while a player logs in is not part of
+ * any tick.
+ */
+class MapReplay
+{
+    friend class ACE_Singleton<MapReplay, ACE_Null_Mutex>;
+
+    public:
+        // replays the capture and writes the report, false if the capture can't be used or no captured player got in world
+        bool Run(std::string const& fileName);
+
+    private:
+        MapReplay();
+        ~MapReplay() {}
+
+        struct Tick
+        {
+            uint32 diff;
+            uint32 worldTime;                               // microseconds spent in World::Update
+            uint32 mapTime;                                 // milliseconds of the map update, 0 if the map was not updated
+            bool mapUpdated;
+            uint32 packets;
+            uint32 allocations;                             // object pool allocations
+        };
+
+        bool Load(std::string const& fileName);
+        void CheckSpawns();
+
+        void Join();
+        void Leave();
+        void ReadPacket();
+        void RunTick(uint32 diff);
+        void LogoutAll();
+
+        void WriteReport(std::string const& captureFile, Profiler::EntryMap const& entries);
+        void LogSummary(Profiler::EntryMap const& entries);
+
+        static uint64 GetPoolAllocations();
+
+        typedef std::map<uint32/*account*/, WorldSession*> SessionMap;
+        typedef std::vector<std::pair<uint32/*account*/, WorldPacket*> > PacketList;
+
+        ByteBuffer m_data;
+        uint32 m_mapId;
+        uint32 m_seed;
+        uint32 m_spawns;
+        uint32 m_spawnMismatches;                           // spawns missing or moved in this world database
+        uint32 m_joins;                                     // logins of captured players
+        uint32 m_failedLogins;                              // of them, those that did not reach the world
+
+        SessionMap m_sessions;
+        std::vector<Tick> m_ticks;
+        PacketList m_tickPackets;                           // packets of the next tick, queued once its joins and leaves are done
+        std::vector<uint64> m_poolAllocations;              // per pool, at the start of the replay
+};
+
+#define sMapReplay ACE_Singleton<MapReplay, ACE_Null_Mutex>::instance()
+
+#endif
@@ -24,6 +24,7 @@
 
 #include <ace/Guard_T.h>
 #include <ace/Method_Request.h>
+#include <algorithm>
 
 class WDBThreadStartReq1 : public ACE_Method_Request
 {
@@ -70,7 +71,7 @@ class MapUpdateRequest : public ACE_Method_Request
 
         virtual int call()
         {
-            m_map.Update (m_diff);
+            m_map.TimedUpdate(m_diff);
             m_updater.update_finished ();
             return 0;
         }
@@ -125,6 +126,25 @@ int MapUpdater::schedule_update(Map& map, ACE_UINT32 diff)
     return 0;
 }
 
+struct MapUpdateTimeOrderPred
+{
+    bool operator()(Map const* left, Map const* right) const
+    {
+        return left->GetUpdateStats().last > right->GetUpdateStats().last;
+    }
+};
+
+void MapUpdater::schedule_updates(std::vector<Map*>& maps, ACE_UINT32 diff)
+{
+    // the tick lasts as long as its slowest map, starting the maps that took longest last time
+    // first lets the short ones fill the other threads meanwhile instead of queueing before them
+    std::sort(maps.begin(), maps.end(), MapUpdateTimeOrderPred());
+
+    for (std::vector<Map*>::iterator itr = maps.begin(); itr != maps.end(); ++itr)
+        if (!activated() || schedule_update(**itr, diff) == -1)
+            (*itr)->TimedUpdate(diff);
+}
+
 bool MapUpdater::activated()
 {
     return m_executor.activated();
@@ -25,6 +25,8 @@
 
 #include "DelayExecutor.h"
 
+#include <vector>
+
 class Map;
 
 class MapUpdater
@@ -38,6 +40,9 @@ class MapUpdater
 
         int schedule_update(Map& map, ACE_UINT32 diff);
 
+        // schedules all maps slowest first, or updates them in place when the updater is not active
+        void schedule_updates(std::vector<Map*>& maps, ACE_UINT32 diff);
+
         int wait();
 
         int activate(size_t num_threads);
@@ -95,7 +95,6 @@ namespace Movement
         int32 next_timestamp() const { return spline.length(point_Idx+1);}
         int32 segment_time_elapsed() const { return next_timestamp()-time_passed;}
        // int32 Duration() const { return spline.length();}
-        int32 timeElapsed() const { return Duration() - time_passed;}
         int32 timePassed() const { return time_passed;}
 
     public:
@@ -136,6 +135,8 @@ namespace Movement
         const Vector3 CurrentDestination() const { return Initialized() ? spline.getPoint(point_Idx+1) : Vector3();}
         int32 currentPathIdx() const;
         int32 Duration() const { return spline.length();}
+        // time left until the end of the spline
+        int32 timeElapsed() const { return Duration() - time_passed;}
         std::string ToString() const;
     };
 }
@@ -20,6 +20,7 @@
 #include "MoveSpline.h"
 #include "MovementPacketBuilder.h"
 #include "Unit.h"
+#include "Map.h"
 
 namespace Movement
 {
@@ -54,6 +55,7 @@ namespace Movement
     int32 MoveSplineInit::Launch()
     {
         MoveSpline& move_spline = *unit.movespline;
+        unit.UpdateSplineState();
 
         Location real_position(unit.GetPositionX(),unit.GetPositionY(),unit.GetPositionZ(),unit.GetOrientation());
         // there is a big chane that current position is unknown if current state is not finalized, need compute it
@@ -94,7 +96,10 @@ namespace Movement
         WorldPacket data(SMSG_MONSTER_MOVE, 64);
         data.append(unit.GetPackGUID());
         PacketBuilder::WriteMonsterMove(move_spline, data);
-        unit.SendMessageToSet(&data, true);
+        if (unit.IsInWorld())
+            unit.GetMap()->SendMonsterMove(&unit, &data);
+        else
+            unit.SendMessageToSet(&data, true);
 
         return move_spline.Duration();
     }
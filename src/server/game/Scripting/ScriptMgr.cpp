@@ -28,6 +28,7 @@
 #include "ScriptSystem.h"
 #include "Transport.h"
 #include "Vehicle.h"
+#include "Profiler.h"
 
 // This is the global static registry of scripts.
 template<class TScript>
@@ -480,11 +481,17 @@ void ScriptMgr::OnPacketReceive(WorldSocket* socket, WorldPacket packet)
     FOREACH_SCRIPT(ServerScript)->OnPacketReceive(socket, packet);
 }
 
-void ScriptMgr::OnPacketSend(WorldSocket* socket, WorldPacket packet)
+void ScriptMgr::OnPacketSend(WorldSocket* socket, WorldPacket const& packet)
 {
     ASSERT(socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnPacketSend(socket, packet);
+    // Only copy the packet when some script is going to look at it, every sent packet goes through here
+    if (SCR_REG_LST(ServerScript).empty())
+        return;
+
+    // Scripts get a copy of the original packet; this is to avoid issues if a hook modifies it.
+    WorldPacket copy(packet);
+    FOREACH_SCRIPT(ServerScript)->OnPacketSend(socket, copy);
 }
 
 void ScriptMgr::OnUnknownPacketReceive(WorldSocket* socket, WorldPacket packet)
@@ -521,6 +528,7 @@ void ScriptMgr::OnShutdownCancel()
 
 void ScriptMgr::OnWorldUpdate(uint32 diff)
 {
+    PROFILE_SCRIPT_HOOK_SCOPE();
     FOREACH_SCRIPT(WorldScript)->OnUpdate(diff);
 }
 
@@ -687,6 +695,7 @@ void ScriptMgr::OnPlayerLeaveMap(Map* map, Player* player)
 void ScriptMgr::OnMapUpdate(Map* map, uint32 diff)
 {
     ASSERT(map);
+    PROFILE_SCRIPT_HOOK_SCOPE();
 
     SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsContinent);
         itr->second->OnUpdate(map, diff);
@@ -864,6 +873,7 @@ void ScriptMgr::OnCreatureUpdate(Creature* creature, uint32 diff)
     ASSERT(creature);
 
     GET_SCRIPT(CreatureScript, creature->GetScriptId(), tmpscript);
+    PROFILE_SCRIPT_HOOK_SCOPE();
     tmpscript->OnUpdate(creature, diff);
 }
 
@@ -950,6 +960,7 @@ void ScriptMgr::OnGameObjectUpdate(GameObject* go, uint32 diff)
     ASSERT(go);
 
     GET_SCRIPT(GameObjectScript, go->GetScriptId(), tmpscript);
+    PROFILE_SCRIPT_HOOK_SCOPE();
     tmpscript->OnUpdate(go, diff);
 }
 
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PacketRateLimiter.h"
+#include "Opcodes.h"
+#include "Config.h"
+#include "Log.h"
+#include "Timer.h"
+#include "Util.h"
+
+#include <ace/Guard_T.h>
+
+void PacketRateLimiter::LoadFromConfig()
+{
+    // "OPCODE_NAME:rate:burst" entries separated by spaces
+    std::string config = ConfigMgr::GetStringDefault("PacketRateLimit.Opcodes", "");
+
+    std::map<std::string, uint32> opcodes;
+    if (!config.empty())
+        for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+            if (strcmp(opcodeTable[i].name, "UNKNOWN") != 0)
+                opcodes[opcodeTable[i].name] = i;
+
+    LimitMap limits;
+    Tokens entries(config, ' ');
+    for (Tokens::const_iterator itr = entries.begin(); itr != entries.end(); ++itr)
+    {
+        Tokens fields(*itr, ':');
+        std::map<std::string, uint32>::const_iterator opcode = fields.size() == 3 ? opcodes.find(fields[0]) : opcodes.end();
+        Limit limit;
+        limit.rate = fields.size() == 3 ? atoi(fields[1]) : 0;
+        limit.burst = fields.size() == 3 ? atoi(fields[2]) : 0;
+        if (opcode == opcodes.end() || !limit.rate || !limit.burst)
+        {
+            sLog->outError("PacketRateLimit.Opcodes: invalid entry '%s', expected OPCODE_NAME:rate:burst with a known opcode, skipped.", *itr);
+            continue;
+        }
+
+        limits[opcode->second] = limit;
+    }
+
+    SKYFIRE_WRITE_GUARD(ACE_RW_Thread_Mutex, m_lock);
+    m_limits.swap(limits);
+    m_active = !m_limits.empty();
+
+    if (m_active.value())
+        sLog->outString("Loaded %u packet rate limits.", uint32(m_limits.size()));
+}
+
+bool PacketRateLimiter::Allow(uint32 opcode, PacketRateBucketMap& buckets)
+{
+    if (!m_active.value())
+        return true;
+
+    Limit limit;
+    {
+        SKYFIRE_READ_GUARD(ACE_RW_Thread_Mutex, m_lock);
+        LimitMap::const_iterator itr = m_limits.find(opcode);
+        if (itr == m_limits.end())
+            return true;
+
+        limit = itr->second;
+    }
+
+    uint32 now = getMSTime();
+    uint32 capacity = limit.burst * 1000;
+
+    PacketRateBucketMap::iterator itr = buckets.find(opcode);
+    if (itr == buckets.end())
+    {
+        // a new connection starts with a full bucket
+        itr = buckets.insert(PacketRateBucketMap::value_type(opcode, PacketRateBucket())).first;
+        itr->second.tokens = capacity;
+    }
+    else
+    {
+        // rate tokens per second are rate thousandths per millisecond
+        uint64 tokens = itr->second.tokens + uint64(getMSTimeDiff(itr->second.lastRefill, now)) * limit.rate;
+        itr->second.tokens = uint32(std::min<uint64>(tokens, capacity));
+    }
+
+    itr->second.lastRefill = now;
+    if (itr->second.tokens < 1000)
+        return false;
+
+    itr->second.tokens -= 1000;
+    return true;
+}
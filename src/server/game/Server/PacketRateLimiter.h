@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PACKET_RATE_LIMITER_H
+#define _PACKET_RATE_LIMITER_H
+
+#include "Common.h"
+
+#include <ace/Singleton.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/RW_Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
+
+// tokens left of one opcode on one connection
+struct PacketRateBucket
+{
+    PacketRateBucket() : tokens(0), lastRefill(0) {}
+
+    uint32 tokens;                                          // in 1/1000 of a packet
+    uint32 lastRefill;
+};
+
+typedef UNORDERED_MAP<uint32, PacketRateBucket> PacketRateBucketMap;
+
+/*
+ * Token bucket limits for client opcodes, configured by PacketRateLimit.Opcodes.
+ * Every connection owns its buckets, WorldSocket checks them before a packet is
+ * queued to the session, so flooded packets never reach the world or map threads.
+ */
+class PacketRateLimiter
+{
+    friend class ACE_Singleton<PacketRateLimiter, ACE_Thread_Mutex>;
+
+    public:
+        struct Limit
+        {
+            uint32 rate;                                    // packets per second
+            uint32 burst;                                   // packets accepted at once
+        };
+
+        // needs the opcode table, called when the network starts and on config reload
+        void LoadFromConfig();
+
+        // takes a token from the bucket of the opcode, false if the packet has to be dropped
+        bool Allow(uint32 opcode, PacketRateBucketMap& buckets);
+
+    private:
+        PacketRateLimiter() : m_active(false) {}
+
+        typedef UNORDERED_MAP<uint32, Limit> LimitMap;
+
+        ACE_RW_Thread_Mutex m_lock;                         // protects m_limits
+        LimitMap m_limits;
+        ACE_Atomic_Op<ACE_Thread_Mutex, bool> m_active;    // any limit configured, read without m_lock
+};
+
+#define sPacketRateLimiter ACE_Singleton<PacketRateLimiter, ACE_Thread_Mutex>::instance()
+
+#endif
@@ -45,6 +45,8 @@
 #include "Transport.h"
 #include "WardenWin.h"
 #include "WardenMac.h"
+#include "Profiler.h"
+#include "MapCapture.h"
 
 bool MapSessionFilter::Process(WorldPacket* packet)
 {
@@ -97,7 +99,7 @@ m_playerRecentlyLogout(false), m_playerSave(false),
 m_sessionDbcLocale(sWorld->GetAvailableDbcLocale(locale)),
 m_sessionDbLocaleIndex(locale),
 m_latency(0), m_TutorialsChanged(false), recruiterId(recruiter),
-isRecruiter(isARecruiter), timeLastWhoCommand(0)
+isRecruiter(isARecruiter), timeLastWhoCommand(0), _throttledPackets(0), _replaySession(false)
 {
     _warden = NULL;
 
@@ -200,6 +202,40 @@ void WorldSession::SendPacket(WorldPacket const* packet)
         m_Socket->CloseSocket();
 }
 
+/**
+ * Send the same packet to several players.
+ * Recipients are resolved under a single lock of the player storage and the packet is
+ * only serialized into each socket's output buffer, never copied as a WorldPacket.
+ *
+ * @param packet packet to send
+ * @param guids guids of the recipients, offline ones are skipped
+ * @param senderGuid if set, recipients ignoring this player are skipped
+ * @return number of sessions the packet was sent to
+ */
+uint32 WorldSession::BroadcastPacket(WorldPacket const* packet, std::vector<uint64> const& guids, uint64 senderGuid /*= 0*/)
+{
+    std::vector<Player*> players;
+    ObjectAccessor::FindPlayers(guids, players);
+
+    uint32 sent = 0;
+    for (std::vector<Player*>::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+    {
+        Player* player = *itr;
+        if (senderGuid && player->GetSocial()->HasIgnore(GUID_LOPART(senderGuid)))
+            continue;
+
+        if (WorldSession* session = player->GetSession())
+        {
+            session->SendPacket(packet);
+            ++sent;
+        }
+    }
+
+    sLog->outDebug(LOG_FILTER_NETWORKIO, "WorldSession::BroadcastPacket: %s (0x%.4X) sent to %u of %u recipients",
+        LookupOpcodeName(packet->GetOpcode()), packet->GetOpcode(), sent, uint32(guids.size()));
+    return sent;
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
@@ -230,7 +266,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     ///- Before we process anything:
     /// If necessary, kick the player from the character select screen
-    if (IsConnectionIdle())
+    if (m_Socket && IsConnectionIdle())
         m_Socket->CloseSocket();
 
     ///- Retrieve packets from the receive queue and call the appropriate handlers
@@ -245,11 +281,17 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     //! delayed packets that were re-enqueued due to improper timing. To prevent an infinite
     //! loop caused by re-enqueueing the same packets over and over again, we stop updating this session
     //! and continue updating others. The re-enqueued packets will be handled in the next Update call for this session.
-    while (m_Socket && !m_Socket->IsClosed() &&
+    while ((_replaySession || (m_Socket && !m_Socket->IsClosed())) &&
             !_recvQueue.empty() && _recvQueue.peek(true) != firstDelayedPacket &&
             _recvQueue.next(packet, updater))
     {
         OpcodeHandler const &opHandle = opcodeTable[packet->GetOpcode()];
+        OpcodeStats& opcodeStats = _opcodeStats[packet->GetOpcode()];
+        opcodeStats.bytes += packet->size();
+        ProfileScope profile(PROFILE_OPCODE, packet->GetOpcode(), opHandle.name, &opcodeStats.time);
+
+        if (sMapCapture->IsCapturing())
+            sMapCapture->RecordPacket(this, *packet);
 
         // Opcode display while only while debugging.
         sLog->outDebug(LOG_FILTER_OPCODES, "SESSION: Received opcode 0x%.4X (%s)", packet->GetOpcode(), packet->GetOpcode()>OPCODE_NOT_FOUND?"nf":LookupOpcodeName(packet->GetOpcode()));
@@ -382,7 +424,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
             m_Socket = NULL;
         }
 
-        if (!m_Socket)
+        if (!m_Socket && !_replaySession)
             return false;                                       //Will remove this session from the world session map
     }
 
@@ -396,6 +438,10 @@ void WorldSession::LogoutPlayer(bool Save)
     while (_player && _player->IsBeingTeleportedFar())
         HandleMoveWorldportAckOpcode();
 
+    // replays rewrite the position of joining characters, a late async save would overwrite it
+    if (_replaySession)
+        Save = false;
+
     m_playerLogout = true;
     m_playerSave = Save;
 
@@ -31,6 +31,9 @@
 #include "World.h"
 #include "WorldPacket.h"
 #include "Cryptography/BigNumber.h"
+#include "Profiler.h"
+
+#include <ace/Atomic_Op.h>
 
 class CalendarEvent;
 class CalendarInvite;
@@ -237,6 +240,7 @@ class WorldSession
         void WriteMovementInfo(WorldPacket* data, MovementInfo* mi);
 
         void SendPacket(WorldPacket const* packet);
+        static uint32 BroadcastPacket(WorldPacket const* packet, std::vector<uint64> const& guids, uint64 senderGuid = 0);
         void SendNotification(const char *format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(uint32 string_id, ...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName *declinedName);
@@ -377,6 +381,34 @@ class WorldSession
 
         uint32 GetLatency() const { return m_latency; }
         void SetLatency(uint32 latency) { m_latency = latency; }
+
+        // packets handled by this session, by opcode
+        struct OpcodeStats
+        {
+            OpcodeStats() : bytes(0) {}
+
+            ProfileEntry time;                              // handler time in microseconds
+            uint64 bytes;
+        };
+
+        typedef UNORDERED_MAP<uint32, OpcodeStats> OpcodeStatsMap;
+
+        // only written by Update(), which never runs concurrently with the world thread commands
+        OpcodeStatsMap const& GetOpcodeStats() const { return _opcodeStats; }
+        // packets the socket dropped because of PacketRateLimit.Opcodes
+        uint32 GetThrottledPackets() const { return uint32(_throttledPackets.value()); }
+        void IncrementThrottledPackets() { ++_throttledPackets; }
+
+        // sessions created by MapReplay have no socket but must keep handling their queued packets
+        void SetReplaySession(bool replay) { _replaySession = replay; }
+        bool IsReplaySession() const { return _replaySession; }
+
+        // EnumData helpers
+        bool CharCanLogin(uint32 lowGUID) const
+        {
+            return _allowedCharsToLogin.find(lowGUID) != _allowedCharsToLogin.end();
+        }
+
         uint32 getDialogStatus(Player* player, Object* questgiver, uint32 defstatus);
 
         time_t m_timeOutTime;
@@ -970,12 +1002,6 @@ class WorldSession
         void LogUnexpectedOpcode(WorldPacket* packet, const char* status, const char *reason);
         void LogUnprocessedTail(WorldPacket* packet);
 
-        // EnumData helpers
-        bool CharCanLogin(uint32 lowGUID)
-        {
-            return _allowedCharsToLogin.find(lowGUID) != _allowedCharsToLogin.end();
-        }
-
         // this stores the GUIDs of the characters who can login
         // characters who failed on Player::BuildEnumData shouldn't login
         std::set<uint32> _allowedCharsToLogin;
@@ -1011,6 +1037,9 @@ class WorldSession
         bool isRecruiter;
         ACE_Based::LockedQueue<WorldPacket*, ACE_Thread_Mutex> _recvQueue;
         time_t timeLastWhoCommand;
+        OpcodeStatsMap _opcodeStats;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> _throttledPackets;
+        bool _replaySession;
 };
 #endif
 /// @}
@@ -33,6 +33,7 @@
 #include "Log.h"
 #include "WorldLog.h"
 #include "ScriptMgr.h"
+#include "Profiler.h"
 
 #include <ace/Message_Block.h>
 #include <ace/OS_NS_string.h>
@@ -189,8 +190,8 @@ int WorldSocket::SendPacket (const WorldPacket& pct)
         return 0;
     }
 
-    // Create a copy of the original packet; this is to avoid issues if a hook modifies it.
-    sScriptMgr->OnPacketSend(this, WorldPacket(pct));
+    // The packet is only copied for the hooks if there are any
+    sScriptMgr->OnPacketSend(this, pct);
 
     ServerPktHeader header(pct.size()+2, pct.GetOpcode());
     m_Crypt.EncryptSend ((uint8*)header.header, header.getHeaderLength());
@@ -697,6 +698,8 @@ int WorldSocket::ProcessIncoming (WorldPacket* new_pct)
     if (closing_)
         return -1;
 
+    Profiler::Record(PROFILE_PACKET_SIZE, opcode, LookupOpcodeName(opcode), uint32(new_pct->size()));
+
     // Dump received packet.
     if (sWorldLog->LogWorld())
     {
@@ -742,6 +745,16 @@ int WorldSocket::ProcessIncoming (WorldPacket* new_pct)
 
                 if (m_Session != NULL)
                 {
+                    // drop flooded packets here, they would only grow the session queue
+                    if (!sPacketRateLimiter->Allow(opcode, m_PacketBuckets))
+                    {
+                        Profiler::Record(PROFILE_PACKET_THROTTLED, opcode, LookupOpcodeName(opcode), uint32(new_pct->size()));
+                        m_Session->IncrementThrottledPackets();
+                        sLog->outDebug(LOG_FILTER_NETWORKIO, "WorldSocket::ProcessIncoming: dropped opcode %s (0x%.4X) from %s, accountid=%u, rate limit exceeded",
+                            LookupOpcodeName(opcode), opcode, GetRemoteAddress().c_str(), m_Session->GetAccountId());
+                        return 0;
+                    }
+
                     // Our Idle timer will reset on any non PING opcodes.
                     // Catches people idling on the login screen and any lingering ingame connections.
                     m_Session->ResetTimeOutTime();
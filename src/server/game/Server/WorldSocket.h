@@ -41,6 +41,7 @@
 
 #include "Common.h"
 #include "AuthCrypt.h"
+#include "PacketRateLimiter.h"
 
 class ACE_Message_Block;
 class WorldPacket;
@@ -169,6 +170,9 @@ class WorldSocket : public WorldHandler
         /// Keep track of over-speed pings, to prevent ping flood.
         uint32 m_OverSpeedPings;
 
+        /// Tokens left of the rate limited opcodes, only used by the reactor thread
+        PacketRateBucketMap m_PacketBuckets;
+
         /// Address of the remote peer
         std::string m_Address;
 
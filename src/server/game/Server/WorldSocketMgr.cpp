@@ -23,6 +23,7 @@
 */
 
 #include "WorldSocketMgr.h"
+#include "PacketRateLimiter.h"
 
 #include <ace/ACE.h>
 #include <ace/Log_Msg.h>
@@ -234,6 +235,9 @@ WorldSocketMgr::StartReactiveIO (ACE_UINT16 port, const char* address)
 {
     m_UseNoDelay = ConfigMgr::GetBoolDefault ("Network.TcpNodelay", true);
 
+    // opcode names are known now
+    sPacketRateLimiter->LoadFromConfig();
+
     int num_threads = ConfigMgr::GetIntDefault ("Network.Threads", 1);
 
     if (num_threads <= 0)
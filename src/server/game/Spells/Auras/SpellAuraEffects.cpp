@@ -411,6 +411,8 @@ pAuraEffectHandler AuraEffectHandler[TOTAL_AURAS]=
     &AuraEffect::HandleModCamouflage,                             // 353 - SPELL_AURA_CAMOUFLAGE
 };
 
+ObjectPool AuraEffect::Pool("AuraEffect", sizeof(AuraEffect));
+
 AuraEffect::AuraEffect(Aura* base, uint8 effIndex, int32 *baseAmount, Unit* caster):
 m_base(base), m_spellInfo(base->GetSpellInfo()), m_effIndex(effIndex),
 m_baseAmount(baseAmount ? *baseAmount : m_spellInfo->Effects[effIndex].BasePoints),
@@ -935,6 +937,21 @@ void AuraEffect::CalculateSpellMod(SpellInfo const *spellInfo, Unit * target)
     GetBase()->CallScriptEffectCalcSpellModHandlers(const_cast<AuraEffect const*>(this), m_spellmod);
 }
 
+void AuraEffect::SetAmount(int32 amount)
+{
+    m_amount = amount;
+    m_canBeRecalculated = false;
+    InvalidateTargetModifierCaches();
+}
+
+void AuraEffect::InvalidateTargetModifierCaches()
+{
+    // aggregated aura modifiers of every target still contain the old amount
+    Aura::ApplicationMap const & targetMap = GetBase()->GetApplicationMap();
+    for (Aura::ApplicationMap::const_iterator appIter = targetMap.begin(); appIter != targetMap.end(); ++appIter)
+        appIter->second->GetTarget()->_InvalidateAuraModifierCache(GetAuraType());
+}
+
 void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
 {
     // Reapply if amount change
@@ -956,7 +973,10 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
     if (handleMask & AURA_EFFECT_HANDLE_CHANGE_AMOUNT)
     {
         if (!mark)
+        {
             m_amount = newAmount;
+            InvalidateTargetModifierCaches();
+        }
         else
             SetAmount(newAmount);
         CalculateSpellMod();
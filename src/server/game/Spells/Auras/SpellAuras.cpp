@@ -37,6 +37,8 @@
 #include "SpellScript.h"
 #include "Vehicle.h"
 
+ObjectPool AuraApplication::Pool("AuraApplication", sizeof(AuraApplication));
+
 AuraApplication::AuraApplication(Unit* target, Unit* caster, Aura* aura, uint8 effMask):
 _target(target), _base(aura), _slot(MAX_AURAS), _flags(AFLAG_NONE),
 _effectsToApply(effMask), _removeMode(AURA_REMOVE_NONE), _needClientUpdate(false)
@@ -344,6 +346,8 @@ Aura* Aura::Create(SpellInfo const* spellproto, uint8 effMask, WorldObject* owne
     return aura;
 }
 
+ObjectPool Aura::Pool("Aura", std::max(sizeof(UnitAura), sizeof(DynObjAura)));
+
 Aura::Aura(SpellInfo const* spellproto, WorldObject* owner, Unit* caster, Item* castItem, uint64 casterGUID) :
 m_spellInfo(spellproto), m_casterGuid(casterGUID ? casterGUID : caster->GetGUID()),
 m_castItemGuid(castItem ? castItem->GetGUID() : 0), m_applyTime(time(NULL)),
@@ -22,6 +22,7 @@
 
 #include "SpellAuraDefines.h"
 #include "SpellInfo.h"
+#include "ObjectPool.h"
 
 class Unit;
 class SpellInfo;
@@ -61,6 +62,9 @@ class AuraApplication
         void _InitFlags(Unit* caster, uint8 effMask);
         void _HandleEffect(uint8 effIndex, bool apply);
     public:
+        static ObjectPool Pool;
+        static void* operator new(size_t size) { return Pool.Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { Pool.Deallocate(ptr, size); }
 
         Unit* GetTarget() const { return _target; }
         Aura* GetBase() const { return _base; }
@@ -96,6 +100,11 @@ class Aura
         void _InitEffects(uint8 effMask, Unit* caster, int32 *baseAmount);
         virtual ~Aura();
 
+        // shared by UnitAura and DynObjAura, blocks fit the larger of both
+        static ObjectPool Pool;
+        static void* operator new(size_t size) { return Pool.Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { Pool.Deallocate(ptr, size); }
+
         SpellInfo const* GetSpellInfo() const { return m_spellInfo; }
         uint32 GetId() const{ return GetSpellInfo()->Id; }
 
@@ -24,6 +24,7 @@
 #include "SharedDefines.h"
 #include "ObjectMgr.h"
 #include "SpellInfo.h"
+#include "ObjectPool.h"
 
 class Unit;
 class Player;
@@ -358,6 +359,10 @@ class Spell
         Spell(Unit* caster, SpellInfo const* info, TriggerCastFlags triggerFlags, uint64 originalCasterGUID = 0, bool skipCheck = false);
         ~Spell();
 
+        static ObjectPool Pool;
+        static void* operator new(size_t size) { return Pool.Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { Pool.Deallocate(ptr, size); }
+
         void InitExplicitTargets(SpellCastTargets const& targets);
         void SelectExplicitTargets();
 
@@ -83,6 +83,11 @@
 #include "Warden.h"
 #include "CalendarMgr.h"
 #include "ItemInfo.h"
+#include "WorldLoader.h"
+#include "Profiler.h"
+#include "ObjectPool.h"
+#include "PacketRateLimiter.h"
+#include "MapCapture.h"
 
 //TODO REMOVE
 #include "CreatureAISelector.h"
@@ -605,6 +610,7 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_PRESERVE_CUSTOM_CHANNELS] = ConfigMgr::GetBoolDefault("PreserveCustomChannels", false);
     m_int_configs[CONFIG_PRESERVE_CUSTOM_CHANNEL_DURATION] = ConfigMgr::GetIntDefault("PreserveCustomChannelDuration", 14);
     m_bool_configs[CONFIG_GRID_UNLOAD] = ConfigMgr::GetBoolDefault("GridUnload", true);
+    m_bool_configs[CONFIG_GRID_PREFETCH] = ConfigMgr::GetBoolDefault("GridPrefetch", false);
     m_int_configs[CONFIG_INTERVAL_SAVE] = ConfigMgr::GetIntDefault("PlayerSaveInterval", 15 * MINUTE * IN_MILLISECONDS);
     m_int_configs[CONFIG_INTERVAL_DISCONNECT_TOLERANCE] = ConfigMgr::GetIntDefault("DisconnectToleranceInterval", 0);
     m_bool_configs[CONFIG_STATS_SAVE_ONLY_ON_LOGOUT] = ConfigMgr::GetBoolDefault("PlayerSave.Stats.SaveOnlyOnLogout", true);
@@ -1177,6 +1183,14 @@ void World::LoadConfigSettings(bool reload)
     m_visibility_notify_periodInInstances = ConfigMgr::GetIntDefault("Visibility.Notify.Period.InInstances",  DEFAULT_VISIBILITY_NOTIFY_PERIOD);
     m_visibility_notify_periodInBGArenas = ConfigMgr::GetIntDefault("Visibility.Notify.Period.InBGArenas",   DEFAULT_VISIBILITY_NOTIFY_PERIOD);
 
+    m_int_configs[CONFIG_VISIBILITY_CROWD_PLAYERS] = ConfigMgr::GetIntDefault("Visibility.Crowd.Players", 0);
+    m_float_configs[CONFIG_VISIBILITY_CROWD_MIN_DISTANCE] = ConfigMgr::GetFloatDefault("Visibility.Crowd.MinDistance", 45.0f);
+    if (m_float_configs[CONFIG_VISIBILITY_CROWD_MIN_DISTANCE] < 45*sWorld->getRate(RATE_CREATURE_AGGRO))
+    {
+        sLog->outError("Visibility.Crowd.MinDistance can't be less max aggro radius %f", 45*sWorld->getRate(RATE_CREATURE_AGGRO));
+        m_float_configs[CONFIG_VISIBILITY_CROWD_MIN_DISTANCE] = 45*sWorld->getRate(RATE_CREATURE_AGGRO);
+    }
+
     ///- Load the CharDelete related config options
     m_int_configs[CONFIG_CHARDELETE_METHOD] = ConfigMgr::GetIntDefault("CharDelete.Method", 0);
     m_int_configs[CONFIG_CHARDELETE_MIN_LEVEL] = ConfigMgr::GetIntDefault("CharDelete.MinLevel", 0);
@@ -1240,6 +1254,9 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = ConfigMgr::GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = ConfigMgr::GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = ConfigMgr::GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_WORLD_LOAD_THREADS] = ConfigMgr::GetIntDefault("WorldLoad.Threads", 1);
+    m_bool_configs[CONFIG_WORLD_SNAPSHOT_ENABLE] = ConfigMgr::GetBoolDefault("WorldSnapshot.Enable", false);
+    m_bool_configs[CONFIG_DBC_MEMORY_MAP] = ConfigMgr::GetBoolDefault("DBC.MemoryMap", false);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = ConfigMgr::GetIntDefault("Command.LookupMaxResults", 0);
 
     // chat logging
@@ -1278,6 +1295,11 @@ void World::LoadConfigSettings(bool reload)
 
     // MySQL ping time interval
     m_int_configs[CONFIG_DB_PING_INTERVAL] = ConfigMgr::GetIntDefault("MaxPingTime", 30);
+    m_int_configs[CONFIG_PROFILER_DUMP_INTERVAL] = ConfigMgr::GetIntDefault("Profiler.DumpInterval", 0);
+
+    // at startup the opcode table is not filled yet, WorldSocketMgr loads the limits when the network starts
+    if (reload)
+        sPacketRateLimiter->LoadFromConfig();
 
     // Wintergrasp
     m_bool_configs[CONFIG_WINTERGRASP_ENABLE] = ConfigMgr::GetBoolDefault("Wintergrasp.Enable", false);
@@ -1375,7 +1397,7 @@ void World::SetInitialWorldSettings()
 
     ///- Load the DBC files
     sLog->outString("Initialize data stores...");
-    LoadDBCStores(m_dataPath, m_availableDbcLocaleMask);
+    LoadDBCStores(m_dataPath, m_availableDbcLocaleMask, getBoolConfig(CONFIG_DBC_MEMORY_MAP));
     LoadDB2Stores(m_dataPath);
     DetectDBCLang();
 
@@ -1398,21 +1420,22 @@ void World::SetInitialWorldSettings()
     sLog->outString("Loading instances...");
     sInstanceSaveMgr->LoadInstances();
 
-    sLog->outString("Loading Localization strings...");
-    uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadItemLocales();
-    sObjectMgr->LoadItemSetNameLocales();
-    sObjectMgr->LoadQuestLocales();
-    sObjectMgr->LoadNpcTextLocales();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
+    {
+        // Every locale table is stored in its own container
+        WorldLoader loader("Localization strings");
+        loader.AddStage("creature locales", sObjectMgr, &ObjectMgr::LoadCreatureLocales);
+        loader.AddStage("gameobject locales", sObjectMgr, &ObjectMgr::LoadGameObjectLocales);
+        loader.AddStage("item locales", sObjectMgr, &ObjectMgr::LoadItemLocales);
+        loader.AddStage("item set name locales", sObjectMgr, &ObjectMgr::LoadItemSetNameLocales);
+        loader.AddStage("quest locales", sObjectMgr, &ObjectMgr::LoadQuestLocales);
+        loader.AddStage("npc text locales", sObjectMgr, &ObjectMgr::LoadNpcTextLocales);
+        loader.AddStage("page text locales", sObjectMgr, &ObjectMgr::LoadPageTextLocales);
+        loader.AddStage("gossip menu option locales", sObjectMgr, &ObjectMgr::LoadGossipMenuItemsLocales);
+        loader.AddStage("points of interest locales", sObjectMgr, &ObjectMgr::LoadPointOfInterestLocales);
+        loader.Run(getIntConfig(CONFIG_WORLD_LOAD_THREADS));
+    }
 
     sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    sLog->outString(">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
-    sLog->outString();
 
     sLog->outString("Loading Page Texts...");
     sObjectMgr->LoadPageTexts();
@@ -1614,30 +1637,41 @@ void World::SetInitialWorldSettings()
     sLog->outString("Loading Player level dependent mail rewards...");
     sObjectMgr->LoadMailLevelRewards();
 
-    // Loot tables
-    LoadLootTables();
-
-    sLog->outString("Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    sLog->outString("Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    sLog->outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
-
-    sLog->outString("Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    sLog->outString("Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    sLog->outString("Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    sLog->outString("Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    sLog->outString("Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    sLog->outString("Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    {
+        // Loot stores, skill tables and achievement containers only read the templates loaded above
+        WorldLoader loader("Loot tables, Skill tables and Achievements");
+        std::vector<uint32> lootStages;
+        lootStages.push_back(loader.AddStage("creature loot", &LoadLootTemplates_Creature));
+        lootStages.push_back(loader.AddStage("fishing loot", &LoadLootTemplates_Fishing));
+        lootStages.push_back(loader.AddStage("gameobject loot", &LoadLootTemplates_Gameobject));
+        lootStages.push_back(loader.AddStage("item loot", &LoadLootTemplates_Item));
+        lootStages.push_back(loader.AddStage("mail loot", &LoadLootTemplates_Mail));
+        lootStages.push_back(loader.AddStage("milling loot", &LoadLootTemplates_Milling));
+        lootStages.push_back(loader.AddStage("pickpocketing loot", &LoadLootTemplates_Pickpocketing));
+        lootStages.push_back(loader.AddStage("skinning loot", &LoadLootTemplates_Skinning));
+        lootStages.push_back(loader.AddStage("disenchanting loot", &LoadLootTemplates_Disenchant));
+        lootStages.push_back(loader.AddStage("prospecting loot", &LoadLootTemplates_Prospecting));
+        lootStages.push_back(loader.AddStage("spell loot", &LoadLootTemplates_Spell));
+        // reference loot checks the references of all other loot stores
+        uint32 referenceLoot = loader.AddStage("reference loot", &LoadLootTemplates_Reference);
+        for (std::vector<uint32>::const_iterator itr = lootStages.begin(); itr != lootStages.end(); ++itr)
+            loader.AddDependency(referenceLoot, *itr);
+
+        loader.AddStage("skill discovery", &LoadSkillDiscoveryTable);
+        loader.AddStage("skill extra items", &LoadSkillExtraItemTable);
+        loader.AddStage("fishing base skill levels", sObjectMgr, &ObjectMgr::LoadFishingBaseSkillLevel);
+
+        loader.AddStage("achievement references", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementReferenceList);
+        uint32 criteriaList = loader.AddStage("achievement criteria lists", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementCriteriaList);
+        uint32 criteriaData = loader.AddStage("achievement criteria data", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementCriteriaData);
+        loader.AddDependency(criteriaData, criteriaList);
+        uint32 rewards = loader.AddStage("achievement rewards", sAchievementMgr, &AchievementGlobalMgr::LoadRewards);
+        uint32 rewardLocales = loader.AddStage("achievement reward locales", sAchievementMgr, &AchievementGlobalMgr::LoadRewardLocales);
+        loader.AddDependency(rewardLocales, rewards);
+        loader.AddStage("completed achievements", sAchievementMgr, &AchievementGlobalMgr::LoadCompletedAchievements);
+
+        loader.Run(getIntConfig(CONFIG_WORLD_LOAD_THREADS));
+    }
 
     // Delete expired auctions before loading
     sLog->outString("Deleting expired auctions...");
@@ -1798,6 +1832,7 @@ void World::SetInitialWorldSettings()
     m_timers[WUPDATE_DELETECHARS].SetInterval(DAY*IN_MILLISECONDS); // check for chars to delete every day
 
     m_timers[WUPDATE_PINGDB].SetInterval(getIntConfig(CONFIG_DB_PING_INTERVAL)*MINUTE*IN_MILLISECONDS);    // Mysql ping time in minutes
+    m_timers[WUPDATE_PROFILE].SetInterval(getIntConfig(CONFIG_PROFILER_DUMP_INTERVAL)*IN_MILLISECONDS);
 
     //to set mailtimer to return mails every day between 4 and 5 am
     //mailtimer is increased when updating auctions
@@ -1936,6 +1971,69 @@ void World::DetectDBCLang()
     sLog->outString();
 }
 
+void World::DumpProfile()
+{
+    std::string fileName = ConfigMgr::GetStringDefault("Profiler.DumpFile", "profile.txt");
+
+    // write to a temporary file first so readers never see a half written dump
+    std::string tmpFileName = fileName + ".tmp";
+    FILE* file = fopen(tmpFileName.c_str(), "w");
+    if (!file)
+    {
+        sLog->outError("World::DumpProfile: can't create '%s'.", tmpFileName.c_str());
+        return;
+    }
+
+    // one tab separated record per line, times in microseconds and packet sizes in bytes unless stated otherwise
+    fprintf(file, "window\t" UI64FMTD "\t%u\n", uint64(time(NULL)), GetMSTimeDiffToNow(Profiler::GetWindowStart()));
+
+    Profiler::EntryMap entries;
+    Profiler::Collect(entries);
+    for (Profiler::EntryMap::const_iterator itr = entries.begin(); itr != entries.end(); ++itr)
+    {
+        ProfileEntry const& entry = itr->second;
+        fprintf(file, "%s\t%u\t%s\t" UI64FMTD "\t" UI64FMTD "\t%u", Profiler::GetCategoryName(ProfileCategory(itr->first >> 32)),
+            uint32(itr->first), entry.name.c_str(), entry.count, entry.total, entry.max);
+        for (uint8 i = 0; i < PROFILE_TIME_BUCKETS; ++i)
+            fprintf(file, "\t%u", entry.buckets[i]);
+        fprintf(file, "\n");
+    }
+
+    // map update times are in milliseconds and cover the whole uptime
+    std::vector<Map*> maps;
+    sMapMgr->GetAllMaps(maps);
+    for (std::vector<Map*>::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+    {
+        MapUpdateStats const& stats = (*itr)->GetUpdateStats();
+        fprintf(file, "map\t%u\t%u\t%s\t%u\t" UI64FMTD "\t%u", (*itr)->GetId(), (*itr)->GetInstanceId(), (*itr)->GetMapName(),
+            stats.count, stats.total, stats.max);
+        for (uint8 i = 0; i < MAP_UPDATE_TIME_BUCKETS; ++i)
+            fprintf(file, "\t%u", stats.buckets[i]);
+        fprintf(file, "\n");
+    }
+
+    std::vector<ObjectPool*> const& pools = ObjectPool::GetPools();
+    for (std::vector<ObjectPool*>::const_iterator itr = pools.begin(); itr != pools.end(); ++itr)
+    {
+        ObjectPool::Stats stats;
+        (*itr)->GetStats(stats);
+        fprintf(file, "pool\t%s\t" UI64FMTD "\t" UI64FMTD "\t" UI64FMTD "\t%u\t" UI64FMTD "\n", (*itr)->GetName(),
+            stats.allocations, stats.live, stats.oversized, stats.slabs, stats.reserved);
+    }
+
+    bool ok = fclose(file) == 0;
+    if (ok)
+    {
+        remove(fileName.c_str());
+        ok = rename(tmpFileName.c_str(), fileName.c_str()) == 0;
+    }
+
+    if (!ok)
+        sLog->outError("World::DumpProfile: failed to write '%s'.", fileName.c_str());
+
+    Profiler::Reset();
+}
+
 void World::RecordTimeDiff(const char *text, ...)
 {
     if (m_updateTimeCount != 1)
@@ -1998,6 +2096,9 @@ void World::Update(uint32 diff)
 {
     m_updateTime = diff;
 
+    // starts a captured tick and reseeds the random generator of a capture or replay
+    sMapCapture->Update(diff);
+
     if (m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] && diff > m_int_configs[CONFIG_MIN_LOG_UPDATE])
     {
         if (m_updateTimeSum > m_int_configs[CONFIG_INTERVAL_LOG_UPDATE])
@@ -2165,6 +2266,12 @@ void World::Update(uint32 diff)
         WorldDatabase.KeepAlive();
     }
 
+    if (getIntConfig(CONFIG_PROFILER_DUMP_INTERVAL) && m_timers[WUPDATE_PROFILE].Passed())
+    {
+        m_timers[WUPDATE_PROFILE].Reset();
+        DumpProfile();
+    }
+
     // update the instance reset times
     sInstanceSaveMgr->Update();
 
@@ -79,6 +79,7 @@ enum WorldTimers
     WUPDATE_MAILBOXQUEUE,
     WUPDATE_DELETECHARS,
     WUPDATE_PINGDB,
+    WUPDATE_PROFILE,
     WUPDATE_COUNT
 };
 
@@ -90,6 +91,7 @@ enum WorldBoolConfigs
     CONFIG_ALLOW_PLAYER_COMMANDS,
     CONFIG_CLEAN_CHARACTER_DB,
     CONFIG_GRID_UNLOAD,
+    CONFIG_GRID_PREFETCH,
     CONFIG_STATS_SAVE_ONLY_ON_LOGOUT,
     CONFIG_ALLOW_TWO_SIDE_ACCOUNTS,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_CHAT,
@@ -170,6 +172,8 @@ enum WorldBoolConfigs
     CONFIG_TOL_BARAD_ENABLE,
     CONFIG_ENABLE_MMAPS,
     CONFIG_WARDEN_ENABLED,
+    CONFIG_WORLD_SNAPSHOT_ENABLE,
+    CONFIG_DBC_MEMORY_MAP,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -186,6 +190,7 @@ enum WorldFloatConfigs
     CONFIG_CREATURE_FAMILY_ASSISTANCE_RADIUS,
     CONFIG_THREAT_RADIUS,
     CONFIG_CHANCE_OF_GM_SURVEY,
+    CONFIG_VISIBILITY_CROWD_MIN_DISTANCE,
     FLOAT_CONFIG_VALUE_COUNT
 };
 
@@ -244,6 +249,7 @@ enum WorldIntConfigs
     CONFIG_GM_LEVEL_IN_WHO_LIST,
     CONFIG_START_GM_LEVEL,
     CONFIG_GROUP_VISIBILITY,
+    CONFIG_VISIBILITY_CROWD_PLAYERS,
     CONFIG_MAIL_DELIVERY_DELAY,
     CONFIG_UPTIME_UPDATE,
     CONFIG_SKILL_CHANCE_ORANGE,
@@ -305,6 +311,7 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_WORLD_LOAD_THREADS,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -342,6 +349,7 @@ enum WorldIntConfigs
     CONFIG_WARDEN_CLIENT_BAN_DURATION,
     CONFIG_WARDEN_NUM_MEM_CHECKS,
     CONFIG_WARDEN_NUM_OTHER_CHECKS,
+    CONFIG_PROFILER_DUMP_INTERVAL,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -767,6 +775,8 @@ class World
         char const* GetDBVersion() const { return m_DBVersion.c_str(); }
 
         void RecordTimeDiff(const char * text, ...);
+        // writes the profiler window, map update times and pool counters to Profiler.DumpFile and starts a new window
+        void DumpProfile();
 
         void LoadAutobroadcasts();
 
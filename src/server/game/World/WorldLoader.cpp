@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorldLoader.h"
+#include "DatabaseEnv.h"
+#include "Timer.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Method_Request.h>
+
+class WorldLoaderThreadStartReq : public ACE_Method_Request
+{
+    public:
+
+        virtual int call()
+        {
+            MySQL::Thread_Init();
+            return 0;
+        }
+};
+
+class WorldLoaderThreadEndReq : public ACE_Method_Request
+{
+    public:
+
+        virtual int call()
+        {
+            MySQL::Thread_End();
+            return 0;
+        }
+};
+
+class WorldLoaderRequest : public ACE_Method_Request
+{
+    private:
+
+        WorldLoader& m_loader;
+        uint32 m_stage;
+
+    public:
+
+        WorldLoaderRequest(WorldLoader& loader, uint32 stage)
+            : m_loader(loader), m_stage(stage)
+        {
+        }
+
+        virtual int call()
+        {
+            m_loader.RunStage(m_stage);
+            return 0;
+        }
+};
+
+WorldLoader::WorldLoader(const char* name) :
+m_name(name), m_executor(), m_mutex(), m_condition(m_mutex), m_remainingStages(0)
+{
+}
+
+WorldLoader::~WorldLoader()
+{
+    for (std::vector<Stage>::iterator itr = m_stages.begin(); itr != m_stages.end(); ++itr)
+        delete itr->task;
+}
+
+uint32 WorldLoader::AddStage(const char* name, WorldLoaderFunctionTask::LoadFunction function)
+{
+    return AddStage(name, new WorldLoaderFunctionTask(function));
+}
+
+uint32 WorldLoader::AddStage(const char* name, WorldLoaderTask* task)
+{
+    m_stages.push_back(Stage(name, task));
+    return uint32(m_stages.size() - 1);
+}
+
+void WorldLoader::AddDependency(uint32 stage, uint32 dependsOn)
+{
+    ASSERT(stage < m_stages.size() && dependsOn < stage);
+
+    m_stages[stage].dependencies.push_back(dependsOn);
+    m_stages[dependsOn].dependents.push_back(stage);
+}
+
+void WorldLoader::Run(uint32 threads)
+{
+    uint32 oldMSTime = getMSTime();
+
+    if (threads > m_stages.size())
+        threads = m_stages.size();
+
+    if (threads < 2 || m_executor.activate(int(threads), new WorldLoaderThreadStartReq, new WorldLoaderThreadEndReq) == -1)
+    {
+        sLog->outString("Loading %s...", m_name.c_str());
+        for (uint32 i = 0; i < m_stages.size(); ++i)
+            RunStage(i);
+    }
+    else
+    {
+        sLog->outString("Loading %s using %u threads...", m_name.c_str(), threads);
+
+        {
+            SKYFIRE_GUARD(ACE_Thread_Mutex, m_mutex);
+
+            m_remainingStages = m_stages.size();
+            for (uint32 i = 0; i < m_stages.size(); ++i)
+                m_stages[i].pendingDependencies = m_stages[i].dependencies.size();
+
+            for (uint32 i = 0; i < m_stages.size(); ++i)
+                if (!m_stages[i].pendingDependencies)
+                    ScheduleStage(i);
+
+            while (m_remainingStages > 0)
+                m_condition.wait();
+        }
+
+        m_executor.deactivate();
+    }
+
+    ReportTimes(GetMSTimeDiffToNow(oldMSTime));
+}
+
+void WorldLoader::RunStage(uint32 stage)
+{
+    uint32 oldMSTime = getMSTime();
+    m_stages[stage].task->Load();
+    uint32 duration = GetMSTimeDiffToNow(oldMSTime);
+
+    if (!m_executor.activated())
+    {
+        m_stages[stage].duration = duration;
+        return;
+    }
+
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_mutex);
+
+    m_stages[stage].duration = duration;
+    for (std::vector<uint32>::const_iterator itr = m_stages[stage].dependents.begin(); itr != m_stages[stage].dependents.end(); ++itr)
+        if (--m_stages[*itr].pendingDependencies == 0)
+            ScheduleStage(*itr);
+
+    --m_remainingStages;
+    m_condition.broadcast();
+}
+
+// must be called with m_mutex held
+void WorldLoader::ScheduleStage(uint32 stage)
+{
+    if (m_executor.execute(new WorldLoaderRequest(*this, stage)) == -1)
+    {
+        sLog->outError("WorldLoader: failed to schedule stage '%s', loading it in the calling thread", m_stages[stage].name.c_str());
+        m_mutex.release();
+        RunStage(stage);
+        m_mutex.acquire();
+    }
+}
+
+void WorldLoader::ReportTimes(uint32 wallTime) const
+{
+    // Earliest finish time of every stage if there were unlimited threads, the longest chain is the critical path
+    std::vector<uint32> finish(m_stages.size(), 0);
+    std::vector<int32> previous(m_stages.size(), -1);
+    uint32 totalTime = 0;
+    uint32 last = 0;
+
+    for (uint32 i = 0; i < m_stages.size(); ++i)
+    {
+        uint32 start = 0;
+        for (std::vector<uint32>::const_iterator itr = m_stages[i].dependencies.begin(); itr != m_stages[i].dependencies.end(); ++itr)
+        {
+            if (finish[*itr] >= start)
+            {
+                start = finish[*itr];
+                previous[i] = int32(*itr);
+            }
+        }
+
+        finish[i] = start + m_stages[i].duration;
+        totalTime += m_stages[i].duration;
+        if (finish[i] > finish[last])
+            last = i;
+
+        sLog->outDetail("WorldLoader: %s stage '%s' loaded in %u ms", m_name.c_str(), m_stages[i].name.c_str(), m_stages[i].duration);
+    }
+
+    if (m_stages.empty())
+        return;
+
+    std::string path = m_stages[last].name;
+    for (int32 i = previous[last]; i >= 0; i = previous[i])
+        path = m_stages[i].name + " -> " + path;
+
+    sLog->outString(">> Loaded %s (%u stages) in %u ms, %u ms of loader time", m_name.c_str(), uint32(m_stages.size()), wallTime, totalTime);
+    sLog->outString(">> Critical path (%u ms): %s", finish[last], path.c_str());
+    sLog->outString();
+}
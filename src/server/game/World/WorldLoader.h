@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _WORLD_LOADER_H_INCLUDED
+#define _WORLD_LOADER_H_INCLUDED
+
+#include "Define.h"
+#include "DelayExecutor.h"
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+#include <string>
+#include <vector>
+
+/// A single startup loader run by WorldLoader
+class WorldLoaderTask
+{
+    public:
+        virtual ~WorldLoaderTask() {}
+        virtual void Load() = 0;
+};
+
+class WorldLoaderFunctionTask : public WorldLoaderTask
+{
+    public:
+        typedef void (*LoadFunction)();
+
+        explicit WorldLoaderFunctionTask(LoadFunction function) : m_function(function) {}
+        void Load() { m_function(); }
+
+    private:
+        LoadFunction m_function;
+};
+
+template<class T>
+class WorldLoaderMethodTask : public WorldLoaderTask
+{
+    public:
+        typedef void (T::*LoadMethod)();
+
+        WorldLoaderMethodTask(T* object, LoadMethod method) : m_object(object), m_method(method) {}
+        void Load() { (m_object->*m_method)(); }
+
+    private:
+        T* m_object;
+        LoadMethod m_method;
+};
+
+/*
+ * Runs a set of startup loaders (stages) honoring the dependencies between them.
+ * Stages without pending dependencies are executed concurrently on a thread pool,
+ * so every stage registered here must only touch its own containers and read data
+ * loaded by the stages it depends on. Stages may only depend on previously added
+ * stages, which makes registration order a valid sequential order.
+ */
+class WorldLoader
+{
+    public:
+
+        explicit WorldLoader(const char* name);
+        ~WorldLoader();
+
+        friend class WorldLoaderRequest;
+
+        // returns the id of the stage, used to declare dependencies of later stages
+        uint32 AddStage(const char* name, WorldLoaderFunctionTask::LoadFunction function);
+        template<class T>
+        uint32 AddStage(const char* name, T* object, void (T::*method)())
+        {
+            return AddStage(name, new WorldLoaderMethodTask<T>(object, method));
+        }
+
+        void AddDependency(uint32 stage, uint32 dependsOn);
+
+        // runs all stages and blocks until they are done, threads < 2 runs them in registration order
+        void Run(uint32 threads);
+
+    private:
+
+        struct Stage
+        {
+            Stage(const char* stageName, WorldLoaderTask* stageTask) : name(stageName), task(stageTask), pendingDependencies(0), duration(0) {}
+
+            std::string name;
+            WorldLoaderTask* task;
+            std::vector<uint32> dependencies;
+            std::vector<uint32> dependents;
+            uint32 pendingDependencies;
+            uint32 duration;                                // ms
+        };
+
+        uint32 AddStage(const char* name, WorldLoaderTask* task);
+        void RunStage(uint32 stage);
+        void ScheduleStage(uint32 stage);
+        void ReportTimes(uint32 wallTime) const;
+
+        std::string m_name;
+        std::vector<Stage> m_stages;
+
+        DelayExecutor m_executor;
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;
+        uint32 m_remainingStages;
+};
+
+#endif // _WORLD_LOADER_H_INCLUDED
@@ -25,6 +25,7 @@ EndScriptData */
 
 #include "ScriptMgr.h"
 #include "Chat.h"
+#include "AchievementMgr.h"
 
 class achievement_commandscript : public CommandScript
 {
@@ -36,11 +37,12 @@ public:
         static ChatCommand achievementCommandTable[] =
         {
             { "add",           SEC_ADMINISTRATOR,  false,  &HandleAchievementAddCommand,      "", NULL },
+            { "stats",         SEC_ADMINISTRATOR,  true,   &HandleAchievementStatsCommand,    "", NULL },
             { NULL,             0,                  false,  NULL,                              "", NULL }
         };
         static ChatCommand commandTable[] =
         {
-            { "achievement",   SEC_ADMINISTRATOR,  false, NULL,            "", achievementCommandTable },
+            { "achievement",   SEC_ADMINISTRATOR,  true,  NULL,            "", achievementCommandTable },
             { NULL,             0,                  false, NULL,                               "", NULL }
         };
         return commandTable;
@@ -73,6 +75,31 @@ public:
 
         return true;
     }
+
+    // lists the criteria types with the most criteria checked by updates since startup
+    static bool HandleAchievementStatsCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 count = *args ? atoi((char*)args) : 10;
+
+        std::vector<std::pair<uint64, uint32> > types;
+        for (uint32 type = 0; type < ACHIEVEMENT_CRITERIA_TYPE_TOTAL; ++type)
+            if (sAchievementMgr->GetCriteriaUpdateCalls(AchievementCriteriaTypes(type)))
+                types.push_back(std::make_pair(sAchievementMgr->GetCriteriaUpdateVisits(AchievementCriteriaTypes(type)), type));
+
+        std::sort(types.rbegin(), types.rend());
+        if (types.size() > count)
+            types.resize(count);
+
+        for (std::vector<std::pair<uint64, uint32> >::const_iterator itr = types.begin(); itr != types.end(); ++itr)
+        {
+            uint64 calls = sAchievementMgr->GetCriteriaUpdateCalls(AchievementCriteriaTypes(itr->second));
+            handler->PSendSysMessage("Criteria type %u%s: " UI64FMTD " updates, " UI64FMTD " criteria checked",
+                itr->second, AchievementGlobalMgr::IsCriteriaTypeIndexedByMiscValue(AchievementCriteriaTypes(itr->second)) ? " (indexed)" : "",
+                calls, itr->first);
+        }
+
+        return true;
+    }
 };
 
 void AddSC_achievement_commandscript()
@@ -32,6 +32,7 @@ EndScriptData */
 #include "GridNotifiers.h"
 #include "GridNotifiersImpl.h"
 #include "GossipDef.h"
+#include "ObjectPool.h"
 
 #include <fstream>
 
@@ -89,6 +90,8 @@ public:
             { "update",        SEC_ADMINISTRATOR,  false, &HandleDebugUpdateCommand,          "", NULL },
             { "itemexpire",    SEC_ADMINISTRATOR,  false, &HandleDebugItemExpireCommand,      "", NULL },
             { "areatriggers",  SEC_ADMINISTRATOR,  false, &HandleDebugAreaTriggersCommand,    "", NULL },
+            { "pools",         SEC_ADMINISTRATOR,  true,  &HandleDebugPoolsCommand,           "", NULL },
+            { "opcodes",       SEC_ADMINISTRATOR,  true,  &HandleDebugOpcodesCommand,         "", NULL },
             { NULL,             0,                  false, NULL,                               "", NULL }
         };
         static ChatCommand commandTable[] =
@@ -449,6 +452,59 @@ public:
         return true;
     }
 
+    static bool HandleDebugPoolsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        uint32 uptime = std::max<uint32>(sWorld->GetUptime(), 1);
+
+        std::vector<ObjectPool*> const& pools = ObjectPool::GetPools();
+        for (std::vector<ObjectPool*>::const_iterator itr = pools.begin(); itr != pools.end(); ++itr)
+        {
+            ObjectPool::Stats stats;
+            (*itr)->GetStats(stats);
+            handler->PSendSysMessage("%s (%u bytes): " UI64FMTD " allocations (" UI64FMTD "/s), " UI64FMTD " live, " UI64FMTD " oversized, " UI64FMTD " KB in %u slabs",
+                (*itr)->GetName(), uint32((*itr)->GetBlockSize()), stats.allocations, stats.allocations / uptime, stats.live,
+                stats.oversized, stats.reserved / 1024, stats.slabs);
+        }
+
+        return true;
+    }
+
+    // Opcodes that cost the session of a player the most handler time: .debug opcodes [$player]
+    static bool HandleDebugOpcodesCommand(ChatHandler* handler, char const* args)
+    {
+        Player* target;
+        if (!handler->extractPlayerTarget((char*)args, &target))
+            return false;
+
+        WorldSession* session = target->GetSession();
+        WorldSession::OpcodeStatsMap const& opcodes = session->GetOpcodeStats();
+
+        std::vector<WorldSession::OpcodeStatsMap::const_iterator> sorted;
+        for (WorldSession::OpcodeStatsMap::const_iterator itr = opcodes.begin(); itr != opcodes.end(); ++itr)
+            sorted.push_back(itr);
+
+        std::sort(sorted.begin(), sorted.end(), OpcodeTotalTimeOrderPred());
+
+        handler->PSendSysMessage("Session of %s, %u packets dropped by the rate limits, times in microseconds:",
+            target->GetName(), session->GetThrottledPackets());
+        for (size_t i = 0; i < sorted.size() && i < 10; ++i)
+        {
+            WorldSession::OpcodeStats const& stats = sorted[i]->second;
+            handler->PSendSysMessage("%s: " UI64FMTD " packets, " UI64FMTD " bytes, total " UI64FMTD ", max %u",
+                LookupOpcodeName(sorted[i]->first), stats.time.count, stats.bytes, stats.time.total, stats.time.max);
+        }
+
+        return true;
+    }
+
+    struct OpcodeTotalTimeOrderPred
+    {
+        bool operator()(WorldSession::OpcodeStatsMap::const_iterator const& left, WorldSession::OpcodeStatsMap::const_iterator const& right) const
+        {
+            return left->second.time.total > right->second.time.total;
+        }
+    };
+
     //Send notification in channel
     static bool HandleDebugSendChannelNotifyCommand(ChatHandler* handler, char const* args)
     {
@@ -517,6 +517,7 @@ public:
             cInfo->MechanicImmuneMask    = fields[80].GetUInt32();
             cInfo->flags_extra           = fields[81].GetUInt32();
             cInfo->ScriptID              = sObjectMgr->GetScriptId(fields[82].GetCString());
+            cInfo->InitAIProfile();
 
             sObjectMgr->CheckCreatureTemplate(cInfo);
         }
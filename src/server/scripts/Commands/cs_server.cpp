@@ -27,6 +27,10 @@ EndScriptData */
 #include "Chat.h"
 #include "SystemConfig.h"
 #include "Config.h"
+#include "MapManager.h"
+#include "GridMapPrefetcher.h"
+#include "Profiler.h"
+#include "MapCapture.h"
 
 class server_commandscript : public CommandScript
 {
@@ -75,13 +79,16 @@ public:
 
         static ChatCommand serverCommandTable[] =
         {
+            { "capture",        SEC_ADMINISTRATOR,  true,  &HandleServerCaptureCommand,           "", NULL },
             { "corpses",        SEC_GAMEMASTER,     true,  &HandleServerCorpsesCommand,           "", NULL },
             { "exit",           SEC_CONSOLE,        true,  &HandleServerExitCommand,              "", NULL },
             { "idlerestart",    SEC_ADMINISTRATOR,  true,  NULL,         "", serverIdleRestartCommandTable },
             { "idleshutdown",   SEC_ADMINISTRATOR,  true,  NULL,        "", serverIdleShutdownCommandTable },
             { "info",           SEC_PLAYER,         true,  &HandleServerInfoCommand,              "", NULL },
+            { "maps",           SEC_ADMINISTRATOR,  true,  &HandleServerMapsCommand,              "", NULL },
             { "motd",           SEC_PLAYER,         true,  &HandleServerMotdCommand,              "", NULL },
             { "plimit",         SEC_ADMINISTRATOR,  true,  &HandleServerPLimitCommand,            "", NULL },
+            { "profile",        SEC_ADMINISTRATOR,  true,  &HandleServerProfileCommand,           "", NULL },
             { "restart",        SEC_ADMINISTRATOR,  true,  NULL,             "", serverRestartCommandTable },
             { "shutdown",       SEC_ADMINISTRATOR,  true,  NULL,            "", serverShutdownCommandTable },
             { "set",            SEC_ADMINISTRATOR,  true,  NULL,                 "", serverSetCommandTable },
@@ -128,6 +135,172 @@ public:
 
         return true;
     }
+    // Maps with the slowest average update and their update time histogram
+    static bool HandleServerMapsCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 count = *args ? uint32(atoi(args)) : 10;
+
+        std::vector<Map*> maps;
+        sMapMgr->GetAllMaps(maps);
+        std::sort(maps.begin(), maps.end(), MapAverageUpdateTimeOrderPred());
+
+        if (count > maps.size())
+            count = maps.size();
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            MapUpdateStats const& stats = maps[i]->GetUpdateStats();
+            std::ostringstream histogram;
+            for (uint8 bucket = 0; bucket < MAP_UPDATE_TIME_BUCKETS; ++bucket)
+            {
+                if (bucket + 1 < MAP_UPDATE_TIME_BUCKETS)
+                    histogram << " <=" << MapUpdateStats::BucketLimits[bucket] << ':' << stats.buckets[bucket];
+                else
+                    histogram << " >" << MapUpdateStats::BucketLimits[bucket - 1] << ':' << stats.buckets[bucket];
+            }
+
+            handler->PSendSysMessage("%s (map %u, instance %u): %u updates, avg %u ms, last %u ms, max %u ms,%s, visibility %u notifies / %u objects",
+                maps[i]->GetMapName(), maps[i]->GetId(), maps[i]->GetInstanceId(), stats.count,
+                stats.count ? uint32(stats.total / stats.count) : 0, stats.last, stats.max, histogram.str().c_str(),
+                stats.visibilityNotifies, stats.visibilityObjects);
+        }
+
+        if (sGridMapPrefetcher->IsActive())
+        {
+            GridMapPrefetcher::Stats prefetch;
+            sGridMapPrefetcher->GetStats(prefetch);
+            handler->PSendSysMessage("Grid prefetch: %u requested, %u used, %u expired, %u pending",
+                prefetch.requested, prefetch.used, prefetch.expired, prefetch.pending);
+        }
+
+        return true;
+    }
+
+    // Costliest entries of the running profile window: .server profile [opcode|ai|hook|bytes|throttled] [count] or .server profile reset
+    static bool HandleServerProfileCommand(ChatHandler* handler, char const* args)
+    {
+        char* param = strtok((char*)args, " ");
+        if (param && strcmp(param, "reset") == 0)
+        {
+            Profiler::Reset();
+            handler->SendSysMessage("Profile window restarted.");
+            return true;
+        }
+
+        int32 category = -1;
+        uint32 count = 10;
+        if (param && !isdigit(*param))
+        {
+            for (uint8 i = 0; i < MAX_PROFILE_CATEGORY; ++i)
+                if (strcmp(param, Profiler::GetCategoryName(ProfileCategory(i))) == 0)
+                    category = i;
+
+            if (category < 0)
+                return false;
+
+            param = strtok(NULL, " ");
+        }
+
+        if (param)
+            count = uint32(atoi(param));
+
+        Profiler::EntryMap entries;
+        Profiler::Collect(entries);
+
+        std::vector<Profiler::EntryMap::const_iterator> sorted;
+        // packet sizes are only listed on request, they don't compare with times
+        for (Profiler::EntryMap::const_iterator itr = entries.begin(); itr != entries.end(); ++itr)
+            if (category < 0 ? int32(itr->first >> 32) < PROFILE_PACKET_SIZE : int32(itr->first >> 32) == category)
+                sorted.push_back(itr);
+
+        std::sort(sorted.begin(), sorted.end(), ProfileTotalTimeOrderPred());
+        if (count > sorted.size())
+            count = sorted.size();
+
+        handler->PSendSysMessage("Profile of the last %u seconds, times in microseconds, packet sizes in bytes:", GetMSTimeDiffToNow(Profiler::GetWindowStart()) / IN_MILLISECONDS);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            ProfileEntry const& entry = sorted[i]->second;
+            std::ostringstream histogram;
+            for (uint8 bucket = 0; bucket < PROFILE_TIME_BUCKETS; ++bucket)
+            {
+                if (bucket + 1 < PROFILE_TIME_BUCKETS)
+                    histogram << " <=" << ProfileEntry::BucketLimits[bucket] << ':' << entry.buckets[bucket];
+                else
+                    histogram << " >" << ProfileEntry::BucketLimits[bucket - 1] << ':' << entry.buckets[bucket];
+            }
+
+            handler->PSendSysMessage("%s %s: " UI64FMTD " calls, total " UI64FMTD ", avg " UI64FMTD ", max %u,%s",
+                Profiler::GetCategoryName(ProfileCategory(sorted[i]->first >> 32)), entry.name.c_str(), entry.count,
+                entry.total, entry.total / entry.count, entry.max, histogram.str().c_str());
+        }
+
+        return true;
+    }
+
+    // Record a continent for replay with worldserver --replay: .server capture #seconds [#mapId] or .server capture stop
+    static bool HandleServerCaptureCommand(ChatHandler* handler, char const* args)
+    {
+        char* param = strtok((char*)args, " ");
+        if (!param)
+            return false;
+
+        if (strcmp(param, "stop") == 0)
+        {
+            if (!sMapCapture->IsCapturing() && !sMapCapture->IsPending())
+            {
+                handler->SendSysMessage("No map capture is running.");
+                handler->SetSentErrorMessage(true);
+                return false;
+            }
+
+            sMapCapture->Stop();
+            handler->SendSysMessage("The map capture ends with the next world tick.");
+            return true;
+        }
+
+        uint32 seconds = uint32(atoi(param));
+        if (!seconds)
+            return false;
+
+        uint32 mapId;
+        if (char* mapParam = strtok(NULL, " "))
+            mapId = uint32(atoi(mapParam));
+        else if (Player* player = handler->GetSession() ? handler->GetSession()->GetPlayer() : NULL)
+            mapId = player->GetMapId();
+        else
+            return false;
+
+        std::string fileName = ConfigMgr::GetStringDefault("MapCapture.File", "capture.bin");
+        if (!sMapCapture->Start(mapId, seconds * IN_MILLISECONDS, fileName))
+        {
+            handler->PSendSysMessage("Can't capture map %u: a capture or replay is already running, or the map is not a continent.", mapId);
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Capturing map %u for %u seconds into '%s'.", mapId, seconds, fileName.c_str());
+        return true;
+    }
+
+    struct ProfileTotalTimeOrderPred
+    {
+        bool operator()(Profiler::EntryMap::const_iterator const& left, Profiler::EntryMap::const_iterator const& right) const
+        {
+            return left->second.total > right->second.total;
+        }
+    };
+
+    struct MapAverageUpdateTimeOrderPred
+    {
+        bool operator()(Map const* left, Map const* right) const
+        {
+            MapUpdateStats const& l = left->GetUpdateStats();
+            MapUpdateStats const& r = right->GetUpdateStats();
+            return (l.count ? l.total / l.count : 0) > (r.count ? r.total / r.count : 0);
+        }
+    };
+
     // Display the 'Message of the day' for the realm
     static bool HandleServerMotdCommand(ChatHandler* handler, char const* args)
     {
@@ -21,6 +21,7 @@
 #include "DBCFileLoader.h"
 #include "Errors.h"
 
+#include <ace/Mem_Map.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -29,66 +30,69 @@ DBCFileLoader::DBCFileLoader()
 {
     data = NULL;
     fieldsOffset = NULL;
+    mapping = NULL;
 }
 
-bool DBCFileLoader::Load(const char* filename, const char* fmt)
+bool DBCFileLoader::Load(const char* filename, const char* fmt, bool memoryMap)
 {
-    uint32 header;
-    if (data)
+    uint32 header[5];
+    if (mapping)
     {
-        delete [] data;
-        data = NULL;
+        delete mapping;
+        mapping = NULL;
     }
+    else if (data)
+        delete [] data;
+    data = NULL;
 
-    FILE* f = fopen(filename, "rb");
-    if (!f)
-        return false;
-
-    if (fread(&header, 4, 1, f) != 1)                           // Number of records
+    if (fieldsOffset)
     {
-        fclose(f);
-        return false;
+        delete [] fieldsOffset;
+        fieldsOffset = NULL;
     }
 
-    EndianConvert(header);
-
-    if (header != 0x43424457)                                //'WDBC'
+    FILE* f = NULL;
+    if (memoryMap)
     {
-        fclose(f);
-        return false;
-    }
+        // Private writable mapping: the core patches a few records after loading, that only copies the touched pages
+        mapping = new ACE_Mem_Map();
+        if (mapping->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_RDWR, ACE_MAP_PRIVATE) == -1 ||
+            mapping->size() < sizeof(header))
+        {
+            delete mapping;
+            mapping = NULL;
+            return false;
+        }
 
-    if (fread(&recordCount, 4, 1, f) != 1)                      // Number of records
-    {
-        fclose(f);
-        return false;
+        memcpy(header, mapping->addr(), sizeof(header));
     }
-
-    EndianConvert(recordCount);
-
-    if (fread(&fieldCount, 4, 1, f) != 1)                       // Number of fields
+    else
     {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(fieldCount);
+        f = fopen(filename, "rb");
+        if (!f)
+            return false;
 
-    if (fread(&recordSize, 4, 1, f) != 1)                       // Size of a record
-    {
-        fclose(f);
-        return false;
+        if (fread(header, sizeof(header), 1, f) != 1)
+        {
+            fclose(f);
+            return false;
+        }
     }
 
-    EndianConvert(recordSize);
+    for (uint32 i = 0; i < 5; ++i)
+        EndianConvert(header[i]);
 
-    if (fread(&stringSize, 4, 1, f) != 1)                       // String size
+    if (header[0] != 0x43424457)                                //'WDBC'
     {
-        fclose(f);
+        if (f)
+            fclose(f);
         return false;
     }
 
-    EndianConvert(stringSize);
+    recordCount = header[1];                                    // Number of records
+    fieldCount = header[2];                                     // Number of fields
+    recordSize = header[3];                                     // Size of a record
+    stringSize = header[4];                                     // String size
 
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
@@ -101,6 +105,16 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
             fieldsOffset[i] += sizeof(uint32);
     }
 
+    if (mapping)
+    {
+        if (mapping->size() < sizeof(header) + recordSize * recordCount + stringSize)
+            return false;
+
+        data = static_cast<unsigned char*>(mapping->addr()) + sizeof(header);
+        stringTable = data + recordSize * recordCount;
+        return true;
+    }
+
     data = new unsigned char[recordSize * recordCount + stringSize];
     stringTable = data + recordSize * recordCount;
 
@@ -117,7 +131,9 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
 
 DBCFileLoader::~DBCFileLoader()
 {
-    if (data)
+    if (mapping)
+        delete mapping;
+    else if (data)
         delete [] data;
 
     if (fieldsOffset)
@@ -130,6 +146,14 @@ DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
     return Record(*this, data + id * recordSize);
 }
 
+ACE_Mem_Map* DBCFileLoader::ReleaseMapping()
+{
+    ACE_Mem_Map* released = mapping;
+    mapping = NULL;
+    data = NULL;
+    return released;
+}
+
 uint32 DBCFileLoader::GetFormatRecordSize(const char * format, int32* index_pos)
 {
     uint32 recordsize = 0;
@@ -175,34 +199,16 @@ uint32 DBCFileLoader::GetFormatRecordSize(const char * format, int32* index_pos)
     return recordsize;
 }
 
-char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**& indexTable, uint32 sqlRecordCount, uint32 sqlHighestIndex, char*& sqlDataTable)
+uint32 DBCFileLoader::CreateIndexTable(int32 indexPos, char**& indexTable, uint32 sqlRecordCount, uint32 sqlHighestIndex)
 {
-    /*
-    format STRING, NA, FLOAT, NA, INT <=>
-    struct{
-    char* field0,
-    float field1,
-    int field2
-    }entry;
-
-    this func will generate  entry[rows] data;
-    */
-
     typedef char* ptr;
-    if (strlen(format) != fieldCount)
-        return NULL;
-
-    //get struct size and index pos
-    int32 i;
-    uint32 recordsize = GetFormatRecordSize(format, &i);
-
-    if (i >= 0)
+    if (indexPos >= 0)
     {
         uint32 maxi = 0;
         //find max index
         for (uint32 y = 0; y < recordCount; ++y)
         {
-            uint32 ind = getRecord(y).getUInt(i);
+            uint32 ind = getRecord(y).getUInt(indexPos);
             if (ind > maxi)
                 maxi = ind;
         }
@@ -212,16 +218,75 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
             maxi = sqlHighestIndex;
 
         ++maxi;
-        records = maxi;
         indexTable = new ptr[maxi];
         memset(indexTable, 0, maxi * sizeof(ptr));
+        return maxi;
     }
-    else
+
+    indexTable = new ptr[recordCount + sqlRecordCount];
+    return recordCount + sqlRecordCount;
+}
+
+bool DBCFileLoader::IsFileLayout(const char* format) const
+{
+#if SKYFIRE_ENDIAN == SKYFIRE_BIGENDIAN
+    return false;
+#else
+    if (strlen(format) != fieldCount || recordSize != fieldCount * sizeof(uint32))
+        return false;
+
+    // strings are stored as offsets and skipped fields are not stored at all, only plain 4 byte values match
+    for (uint32 x = 0; x < fieldCount; ++x)
+        if (format[x] != FT_IND && format[x] != FT_INT && format[x] != FT_FLOAT)
+            return false;
+
+    return true;
+#endif
+}
+
+char* DBCFileLoader::AutoProduceIndex(const char* format, uint32& records, char**& indexTable)
+{
+    ASSERT(mapping && IsFileLayout(format));
+
+    int32 i;
+    GetFormatRecordSize(format, &i);
+
+    records = CreateIndexTable(i, indexTable, 0, 0);
+
+    for (uint32 y = 0; y < recordCount; ++y)
     {
-        records = recordCount + sqlRecordCount;
-        indexTable = new ptr[recordCount+ sqlRecordCount];
+        char* record = reinterpret_cast<char*>(data + y * recordSize);
+        if (i >= 0)
+            indexTable[getRecord(y).getUInt(i)] = record;
+        else
+            indexTable[y] = record;
     }
 
+    return reinterpret_cast<char*>(data);
+}
+
+char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**& indexTable, uint32 sqlRecordCount, uint32 sqlHighestIndex, char*& sqlDataTable)
+{
+    /*
+    format STRING, NA, FLOAT, NA, INT <=>
+    struct{
+    char* field0,
+    float field1,
+    int field2
+    }entry;
+
+    this func will generate  entry[rows] data;
+    */
+
+    if (strlen(format) != fieldCount)
+        return NULL;
+
+    //get struct size and index pos
+    int32 i;
+    uint32 recordsize = GetFormatRecordSize(format, &i);
+
+    records = CreateIndexTable(i, indexTable, sqlRecordCount, sqlHighestIndex);
+
     char* dataTable = new char[(recordCount + sqlRecordCount)*recordsize];
 
     uint32 offset = 0;
@@ -278,8 +343,12 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
     if (strlen(format) != fieldCount)
         return NULL;
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    char* stringPool = reinterpret_cast<char*>(stringTable);
+    if (!mapping)
+    {
+        stringPool = new char[stringSize];
+        memcpy(stringPool, stringTable, stringSize);
+    }
 
     uint32 offset = 0;
 
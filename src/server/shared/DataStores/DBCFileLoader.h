@@ -25,13 +25,16 @@
 
 #include <cassert>
 
+class ACE_Mem_Map;
+
 class DBCFileLoader
 {
     public:
         DBCFileLoader();
         ~DBCFileLoader();
 
-        bool Load(const char *filename, const char *fmt);
+        // memoryMap: map the file copy-on-write instead of reading it, unmodified pages are shared by all processes using it
+        bool Load(const char *filename, const char *fmt, bool memoryMap = false);
 
         class Record
         {
@@ -81,10 +84,19 @@ class DBCFileLoader
         uint32 GetCols() const { return fieldCount; }
         uint32 GetOffset(size_t id) const { return (fieldsOffset != NULL && id < fieldCount) ? fieldsOffset[id] : 0; }
         bool IsLoaded() const { return data != NULL; }
+        bool IsMapped() const { return mapping != NULL; }
+        // true if records of this format are stored in memory exactly as in the file
+        bool IsFileLayout(const char* fmt) const;
         char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable, uint32 sqlRecordCount, uint32 sqlHighestIndex, char *& sqlDataTable);
+        // indexes the records of a mapped file in place, only valid for formats matching IsFileLayout
+        char* AutoProduceIndex(const char* fmt, uint32& count, char**& indexTable);
+        // strings of a mapped file are not copied, they stay valid as long as the mapping
         char* AutoProduceStrings(const char* fmt, char* dataTable);
+        // hands the mapping over to the caller, which must keep it as long as produced data is used and delete it afterwards
+        ACE_Mem_Map* ReleaseMapping();
         static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = NULL);
     private:
+        uint32 CreateIndexTable(int32 indexPos, char**& indexTable, uint32 sqlRecordCount, uint32 sqlHighestIndex);
 
         uint32 recordSize;
         uint32 recordCount;
@@ -93,5 +105,6 @@ class DBCFileLoader
         uint32 *fieldsOffset;
         unsigned char *data;
         unsigned char *stringTable;
+        ACE_Mem_Map *mapping;
 };
 #endif
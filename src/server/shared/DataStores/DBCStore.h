@@ -28,6 +28,8 @@
 #include "Implementation/WorldDatabase.h"
 #include "DatabaseEnv.h"
 
+#include <ace/Mem_Map.h>
+
 struct SqlDbc
 {
     const std::string * formatString;
@@ -71,9 +73,10 @@ template<class T>
 class DBCStorage
 {
     typedef std::list<char*> StringPoolList;
+    typedef std::list<ACE_Mem_Map*> MappedFileList;
     public:
         explicit DBCStorage(const char *f) :
-            fmt(f), nCount(0), fieldCount(0), dataTable(NULL)
+            fmt(f), nCount(0), fieldCount(0), dataTable(NULL), dataTableMapped(false)
         {
             indexTable.asT = NULL;
         }
@@ -88,11 +91,11 @@ class DBCStorage
         char const* GetFormat() const { return fmt; }
         uint32 GetFieldCount() const { return fieldCount; }
 
-        bool Load(char const* fn, SqlDbc* sql)
+        bool Load(char const* fn, SqlDbc* sql, bool memoryMap = false)
         {
             DBCFileLoader dbc;
             // Check if load was sucessful, only then continue
-            if (!dbc.Load(fn, fmt))
+            if (!dbc.Load(fn, fmt, memoryMap))
                 return false;
 
             uint32 sqlRecordCount = 0;
@@ -124,11 +127,20 @@ class DBCStorage
                     }
                 }
             }
-            char * sqlDataTable;
+            char * sqlDataTable = NULL;
             fieldCount = dbc.GetCols();
-            dataTable = (T*)dbc.AutoProduceData(fmt, nCount, indexTable.asChar, sqlRecordCount, sqlHighestIndex, sqlDataTable);
+            // Records stored like in the file are used in place, so their pages stay shared with every other mapping of the file
+            dataTableMapped = !sqlRecordCount && dbc.IsMapped() && dbc.IsFileLayout(fmt);
+            if (dataTableMapped)
+                dataTable = (T*)dbc.AutoProduceIndex(fmt, nCount, indexTable.asChar);
+            else
+                dataTable = (T*)dbc.AutoProduceData(fmt, nCount, indexTable.asChar, sqlRecordCount, sqlHighestIndex, sqlDataTable);
 
-            stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)dataTable));
+            char* stringPool = dbc.AutoProduceStrings(fmt, (char*)dataTable);
+            if (dataTableMapped)
+                mappedFileList.push_back(dbc.ReleaseMapping());
+            else
+                KeepStrings(dbc, stringPool);
 
             // Insert sql data into arrays
             if (result)
@@ -178,7 +190,7 @@ class DBCStorage
                                         break;
                                     case FT_STRING:
                                         // Beginning of the pool - empty string
-                                        *((char**)(&sqlDataTable[offset]))=stringPoolList.back();
+                                        *((char**)(&sqlDataTable[offset]))=stringPool;
                                         offset+=sizeof(char*);
                                         break;
                                 }
@@ -234,7 +246,7 @@ class DBCStorage
            return indexTable.asT!= NULL;
         }
 
-        bool LoadStringsFrom(char const* fn)
+        bool LoadStringsFrom(char const* fn, bool memoryMap = false)
         {
             // DBC must be already loaded using Load
             if (!indexTable.asT)
@@ -242,23 +254,32 @@ class DBCStorage
 
             DBCFileLoader dbc;
             // Check if load was successful, only then continue
-            if (!dbc.Load(fn, fmt))
+            if (!dbc.Load(fn, fmt, memoryMap))
                 return false;
 
-            stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)dataTable));
+            // A mapped string table is only paged in for the strings actually read
+            KeepStrings(dbc, dbc.AutoProduceStrings(fmt, (char*)dataTable));
 
             return true;
         }
 
         void Clear()
         {
+            while (!mappedFileList.empty())
+            {
+                delete mappedFileList.front();
+                mappedFileList.pop_front();
+            }
+
             if (!indexTable.asT)
                 return;
 
             delete[] ((char*)indexTable.asT);
             indexTable.asT = NULL;
-            delete[] ((char*)dataTable);
+            if (!dataTableMapped)
+                delete[] ((char*)dataTable);
             dataTable = NULL;
+            dataTableMapped = false;
 
             while (!stringPoolList.empty())
             {
@@ -269,6 +290,18 @@ class DBCStorage
         }
 
     private:
+        // strings of a mapped file point into the mapping, which then has to live as long as the store
+        void KeepStrings(DBCFileLoader& dbc, char* stringPool)
+        {
+            if (dbc.IsMapped())
+            {
+                if (strchr(fmt, FT_STRING))
+                    mappedFileList.push_back(dbc.ReleaseMapping());
+            }
+            else
+                stringPoolList.push_back(stringPool);
+        }
+
         char const* fmt;
         uint32 nCount;
         uint32 fieldCount;
@@ -281,7 +314,9 @@ class DBCStorage
         indexTable;
 
         T* dataTable;
+        bool dataTableMapped;
         StringPoolList stringPoolList;
+        MappedFileList mappedFileList;
 };
 
 #endif
@@ -226,6 +226,30 @@ class DatabaseWorkerPool
             return QueryResult(result);
         }
 
+        //! Executes an SQL query in string format whose rows are transferred from the server while they are read,
+        //! so large results are never buffered as a whole. Meant for bulk loaders.
+        //! The connection stays locked until the last row was read or the result is released, so no other query
+        //! may be issued on this pool by the calling thread meanwhile. GetRowCount() is always 0 for these results.
+        QueryResult StreamQuery(const char* sql)
+        {
+            T* t = GetFreeConnection();
+            ResultSet* result = t->StreamQuery(sql);
+            if (!result)
+            {
+                t->Unlock();
+                return QueryResult(NULL);
+            }
+
+            //! An empty result unlocks the connection by itself
+            if (!result->NextRow())
+            {
+                delete result;
+                return QueryResult(NULL);
+            }
+
+            return QueryResult(result);
+        }
+
         //! Directly executes an SQL query in string format -with variable args- that will block the calling thread until finished.
         //! Returns reference counted auto pointer, no need for manual memory management in upper level code.
         QueryResult PQuery(const char* sql, MySQLConnection* conn, ...)
@@ -318,12 +342,25 @@ class DatabaseWorkerPool
         //! return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
-        QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder* holder)
+        //! With spread the queries are split over all async connections and executed concurrently,
+        //! which is only allowed for holders of independent read queries.
+        QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder* holder, bool spread = false)
         {
             QueryResultHolderFuture res;
-            SQLQueryHolderTask* task = new SQLQueryHolderTask(holder, res);
-            Enqueue(task);
-            return res;     //! Fool compiler, has no use yet
+            size_t parts = spread ? std::min(size_t(_connectionCount[IDX_ASYNC]), holder->GetSize()) : 1;
+            if (parts < 2)
+            {
+                SQLQueryHolderTask* task = new SQLQueryHolderTask(holder, res);
+                Enqueue(task);
+                return res;     //! Fool compiler, has no use yet
+            }
+
+            SQLQueryHolderPendingParts* pendingParts = new SQLQueryHolderPendingParts(long(parts));
+            size_t size = holder->GetSize();
+            for (size_t i = 0; i < parts; ++i)
+                Enqueue(new SQLQueryHolderTask(holder, res, size * i / parts, size * (i + 1) / parts, pendingParts));
+
+            return res;
         }
 
         /**
@@ -246,7 +246,7 @@ class Field
         #endif
         struct
         {
-            uint32 length;          // Length (prepared strings only)
+            uint32 length;          // Length (strings only)
             void* value;            // Actual data in memory
             enum_field_types type;  // Field type
             bool raw;               // Raw bytes? (Prepared statement or ad hoc)
@@ -257,14 +257,9 @@ class Field
         #pragma pack(pop)
         #endif
 
-        void SetByteValue(const void* newValue, const size_t newSize, enum_field_types newType, uint32 length);
-        void SetStructuredValue(char* newValue, enum_field_types newType);
-
-        void CleanUp()
-        {
-            delete[] ((char*)data.value);
-            data.value = NULL;
-        }
+        // Fields never own their data, it belongs to the result set
+        void SetByteValue(void* newValue, enum_field_types newType, uint32 length);
+        void SetStructuredValue(char* newValue, enum_field_types newType, uint32 length);
 
         static size_t SizeForType(MYSQL_FIELD* field)
         {
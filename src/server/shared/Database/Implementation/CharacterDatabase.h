@@ -259,7 +259,8 @@ enum CharacterDatabaseStatements
 
     // Auras
     CHAR_DEL_AURA,
-    CHAR_INS_AURA,
+    CHAR_DEL_AURA_ENTRY,
+    CHAR_REP_AURA,
 
     // Currency
     CHAR_SEL_CHARACTER_CURRENCY,
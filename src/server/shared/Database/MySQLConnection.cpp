@@ -315,7 +315,24 @@ ResultSet* MySQLConnection::Query(const char* sql)
     return new ResultSet(result, fields, rowCount, fieldCount);
 }
 
-bool MySQLConnection::_Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD **pFields, uint64* pRowCount, uint32* pFieldCount)
+ResultSet* MySQLConnection::StreamQuery(const char* sql)
+{
+    if (!sql)
+        return NULL;
+
+    MYSQL_RES *result = NULL;
+    MYSQL_FIELD *fields = NULL;
+    uint64 rowCount = 0;
+    uint32 fieldCount = 0;
+
+    if (!_Query(sql, &result, &fields, &rowCount, &fieldCount, true))
+        return NULL;
+
+    // Rows are transferred while they are read, the connection is unlocked by the result set
+    return new ResultSet(result, fields, rowCount, fieldCount, this);
+}
+
+bool MySQLConnection::_Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD **pFields, uint64* pRowCount, uint32* pFieldCount, bool stream)
 {
     if (!m_Mysql)
         return false;
@@ -332,7 +349,7 @@ bool MySQLConnection::_Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD *
             sLog->outSQLDriver("ERROR: [%u] %s", lErrno, mysql_error(m_Mysql));
 
             if (_HandleMySQLErrno(lErrno))      // If it returns true, an error was handled successfully (i.e. reconnection)
-                return _Query(sql, pResult, pFields, pRowCount, pFieldCount);    // We try again
+                return _Query(sql, pResult, pFields, pRowCount, pFieldCount, stream);    // We try again
 
             return false;
         }
@@ -341,15 +358,16 @@ bool MySQLConnection::_Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD *
             sLog->outSQLDriver("[%u ms] SQL: %s", getMSTimeDiff(_s, getMSTime()), sql);
         }
 
-        *pResult = mysql_store_result(m_Mysql);
-        *pRowCount = mysql_affected_rows(m_Mysql);
+        // mysql_use_result() leaves the rows on the server until they are fetched, the row count is unknown until then
+        *pResult = stream ? mysql_use_result(m_Mysql) : mysql_store_result(m_Mysql);
+        *pRowCount = stream ? 0 : mysql_affected_rows(m_Mysql);
         *pFieldCount = mysql_field_count(m_Mysql);
     }
 
     if (!*pResult )
         return false;
 
-    if (!*pRowCount)
+    if (!stream && !*pRowCount)
     {
         mysql_free_result(*pResult);
         return false;
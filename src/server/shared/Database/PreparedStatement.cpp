@@ -183,6 +183,41 @@ void PreparedStatement::setString(const uint8 index, const std::string& value)
     statement_data[index].type = TYPE_STRING;
 }
 
+size_t PreparedStatement::GetParametersSize() const
+{
+    size_t size = 0;
+    for (std::vector<PreparedStatementData>::const_iterator itr = statement_data.begin(); itr != statement_data.end(); ++itr)
+    {
+        switch (itr->type)
+        {
+            case TYPE_BOOL:
+            case TYPE_UI8:
+            case TYPE_I8:
+                size += sizeof(uint8);
+                break;
+            case TYPE_UI16:
+            case TYPE_I16:
+                size += sizeof(uint16);
+                break;
+            case TYPE_UI32:
+            case TYPE_I32:
+            case TYPE_FLOAT:
+                size += sizeof(uint32);
+                break;
+            case TYPE_UI64:
+            case TYPE_I64:
+            case TYPE_DOUBLE:
+                size += sizeof(uint64);
+                break;
+            case TYPE_STRING:
+                size += itr->str.size();
+                break;
+        }
+    }
+
+    return size;
+}
+
 MySQLPreparedStatement::MySQLPreparedStatement(MYSQL_STMT* stmt) :
 m_Mstmt(stmt),
 m_bind(NULL)
@@ -88,6 +88,9 @@ class PreparedStatement
         void setDouble(const uint8 index, const double value);
         void setString(const uint8 index, const std::string& value);
 
+        //- Bytes of parameter data sent with the statement
+        size_t GetParametersSize() const;
+
     protected:
         void BindParameters();
 
@@ -163,7 +163,8 @@ bool SQLQueryHolderTask::Execute()
     /// we can do this, we are friends
     std::vector<SQLQueryHolder::SQLResultPair> &queries = m_holder->m_queries;
 
-    for (size_t i = 0; i < queries.size(); i++)
+    size_t end = std::min(m_end, queries.size());
+    for (size_t i = m_begin; i < end; i++)
     {
         /// execute all queries in the holder and pass the results
         if (SQLElementData* data = &queries[i].first)
@@ -188,6 +189,15 @@ bool SQLQueryHolderTask::Execute()
         }
     }
 
+    /// other parts of the holder are still running on other connections
+    if (m_pendingParts)
+    {
+        if (--(*m_pendingParts) > 0)
+            return true;
+
+        delete m_pendingParts;
+    }
+
     m_result.set(m_holder);
     return true;
 }
@@ -19,6 +19,7 @@
 #define _QUERYHOLDER_H
 
 #include <ace/Future.h>
+#include <ace/Atomic_Op.h>
 
 class SQLQueryHolder
 {
@@ -33,6 +34,7 @@ class SQLQueryHolder
         bool SetPQuery(size_t index, const char *format, ...) ATTR_PRINTF(3, 4);
         bool SetPreparedQuery(size_t index, PreparedStatement* stmt);
         void SetSize(size_t size);
+        size_t GetSize() const { return m_queries.size(); }
         QueryResult GetResult(size_t index);
         PreparedQueryResult GetPreparedResult(size_t index);
         void SetResult(size_t index, ResultSet* result);
@@ -41,15 +43,23 @@ class SQLQueryHolder
 
 typedef ACE_Future<SQLQueryHolder*> QueryResultHolderFuture;
 
+typedef ACE_Atomic_Op<ACE_Thread_Mutex, long> SQLQueryHolderPendingParts;
+
 class SQLQueryHolderTask : public SQLOperation
 {
     private:
         SQLQueryHolder * m_holder;
         QueryResultHolderFuture m_result;
+        size_t m_begin;
+        size_t m_end;
+        SQLQueryHolderPendingParts* m_pendingParts;         // shared by all tasks of a holder split in parts
 
     public:
         SQLQueryHolderTask(SQLQueryHolder *holder, QueryResultHolderFuture res)
-            : m_holder(holder), m_result(res){};
+            : m_holder(holder), m_result(res), m_begin(0), m_end(size_t(-1)), m_pendingParts(NULL) {};
+        //! Executes the queries [begin, end) of the holder, the last part to finish sets the result
+        SQLQueryHolderTask(SQLQueryHolder *holder, QueryResultHolderFuture res, size_t begin, size_t end, SQLQueryHolderPendingParts* pendingParts)
+            : m_holder(holder), m_result(res), m_begin(begin), m_end(end), m_pendingParts(pendingParts) {};
         bool Execute();
 };
 
@@ -19,17 +19,21 @@
 #include "DatabaseEnv.h"
 #include "Log.h"
 
-ResultSet::ResultSet(MYSQL_RES *result, MYSQL_FIELD *fields, uint64 rowCount, uint32 fieldCount) :
+ResultSet::ResultSet(MYSQL_RES *result, MYSQL_FIELD *fields, uint64 rowCount, uint32 fieldCount, MySQLConnection* streamConnection) :
 _rowCount(rowCount),
 _fieldCount(fieldCount),
 _result(result),
-_fields(fields)
+_fields(fields),
+_streamConnection(streamConnection),
+_streamError(false)
 {
     _currentRow = new Field[_fieldCount];
     ASSERT(_currentRow);
 }
 
 PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES *result, uint64 rowCount, uint32 fieldCount) :
+m_rows(NULL),
+m_rowData(NULL),
 m_rowCount(rowCount),
 m_rowPosition(0),
 m_fieldCount(fieldCount),
@@ -95,17 +99,31 @@ m_length(NULL)
 
     m_rowCount = mysql_stmt_num_rows(m_stmt);
 
-    m_rows.resize(uint32(m_rowCount));
+    //- All values of a row are copied next to each other into one block allocated for the whole result,
+    //- every slot is padded to 8 bytes to keep numeric values aligned
+    std::vector<size_t> offsets(m_fieldCount);
+    size_t rowSize = 0;
+    for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
+    {
+        offsets[fIndex] = rowSize;
+        rowSize += (m_rBind[fIndex].buffer_length + 7) & ~size_t(7);
+    }
+
+    m_rows = new Field[uint32(m_rowCount) * m_fieldCount];
+    m_rowData = new char[uint32(m_rowCount) * rowSize];
+
     while (_NextRow())
     {
-        m_rows[uint32(m_rowPosition)] = new Field[m_fieldCount];
-        for (uint64 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
+        Field* row = &m_rows[uint32(m_rowPosition) * m_fieldCount];
+        char* rowData = &m_rowData[uint32(m_rowPosition) * rowSize];
+        for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
         {
+            char* value = rowData + offsets[fIndex];
             if (!*m_rBind[fIndex].is_null)
-                m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( m_rBind[fIndex].buffer,
-                                                            m_rBind[fIndex].buffer_length,
-                                                            m_rBind[fIndex].buffer_type,
-                                                           *m_rBind[fIndex].length );
+            {
+                memcpy(value, m_rBind[fIndex].buffer, m_rBind[fIndex].buffer_length);
+                row[fIndex].SetByteValue(value, m_rBind[fIndex].buffer_type, *m_rBind[fIndex].length);
+            }
             else
                 switch (m_rBind[fIndex].buffer_type)
                 {
@@ -115,16 +133,12 @@ m_length(NULL)
                     case MYSQL_TYPE_BLOB:
                     case MYSQL_TYPE_STRING:
                     case MYSQL_TYPE_VAR_STRING:
-                    m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( "",
-                                                            m_rBind[fIndex].buffer_length,
-                                                            m_rBind[fIndex].buffer_type,
-                                                           *m_rBind[fIndex].length );
+                    // NULL strings read as empty strings
+                    memset(value, 0, m_rBind[fIndex].buffer_length);
+                    row[fIndex].SetByteValue(value, m_rBind[fIndex].buffer_type, 0);
                     break;
                     default:
-                    m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( 0,
-                                                            m_rBind[fIndex].buffer_length,
-                                                            m_rBind[fIndex].buffer_type,
-                                                           *m_rBind[fIndex].length );
+                    row[fIndex].SetByteValue(NULL, m_rBind[fIndex].buffer_type, 0);
                 }
         }
         m_rowPosition++;
@@ -142,8 +156,8 @@ ResultSet::~ResultSet()
 
 PreparedResultSet::~PreparedResultSet()
 {
-    for (uint32 i = 0; i < uint32(m_rowCount); ++i)
-        delete[] m_rows[i];
+    delete[] m_rows;
+    delete[] m_rowData;
 }
 
 bool ResultSet::NextRow()
@@ -156,12 +170,22 @@ bool ResultSet::NextRow()
     row = mysql_fetch_row(_result);
     if (!row)
     {
+        // a streamed result also ends on a lost connection or a server error, only the error code tells them apart
+        if (_streamConnection && mysql_errno(_streamConnection->GetHandle()))
+        {
+            sLog->outSQLDriver("%s: streamed result ended early. Error %u: %s", __FUNCTION__,
+                mysql_errno(_streamConnection->GetHandle()), mysql_error(_streamConnection->GetHandle()));
+            _streamError = true;
+        }
+
         CleanUp();
         return false;
     }
 
+    // Fields point into the row buffer of the client library, which stays valid until the next fetch
+    unsigned long* lengths = mysql_fetch_lengths(_result);
     for (uint32 i = 0; i < _fieldCount; i++)
-        _currentRow[i].SetStructuredValue(row[i], _fields[i].type);
+        _currentRow[i].SetStructuredValue(row[i], _fields[i].type, uint32(lengths[i]));
 
     return true;
 }
@@ -207,6 +231,12 @@ void ResultSet::CleanUp()
         mysql_free_result(_result);
         _result = NULL;
     }
+
+    if (_streamConnection)
+    {
+        _streamConnection->Unlock();
+        _streamConnection = NULL;
+    }
 }
 
 void PreparedResultSet::CleanUp()
@@ -30,15 +30,21 @@
 #endif
 #include <mysql.h>
 
+class MySQLConnection;
+
 class ResultSet
 {
     public:
-        ResultSet(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount);
+        // streamConnection: connection a streamed (unbuffered) result is read from, it stays locked
+        // until the last row was fetched or the result is destroyed
+        ResultSet(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount, MySQLConnection* streamConnection = NULL);
         ~ResultSet();
 
         bool NextRow();
         uint64 GetRowCount() const { return _rowCount; }
         uint32 GetFieldCount() const { return _fieldCount; }
+        // a streamed result whose rows ended because the connection or the server failed, not because all were read
+        bool HasStreamError() const { return _streamError; }
 
         Field* Fetch() const { return _currentRow; }
         const Field & operator [] (uint32 index) const
@@ -56,6 +62,8 @@ class ResultSet
         void CleanUp();
         MYSQL_RES* _result;
         MYSQL_FIELD* _fields;
+        MySQLConnection* _streamConnection;
+        bool _streamError;
 };
 
 typedef SkyFire::AutoPtr<ResultSet, ACE_Thread_Mutex> QueryResult;
@@ -73,18 +81,19 @@ class PreparedResultSet
         Field* Fetch() const
         {
             ASSERT(m_rowPosition < m_rowCount);
-            return m_rows[uint32(m_rowPosition)];
+            return &m_rows[uint32(m_rowPosition) * m_fieldCount];
         }
 
         const Field & operator [] (uint32 index) const
         {
             ASSERT(m_rowPosition < m_rowCount);
             ASSERT(index < m_fieldCount);
-            return m_rows[uint32(m_rowPosition)][index];
+            return m_rows[uint32(m_rowPosition) * m_fieldCount + index];
         }
 
     protected:
-        std::vector<Field*> m_rows;
+        Field* m_rows;                                      // m_rowCount * m_fieldCount fields, row major
+        char* m_rowData;                                    // values of all rows, pointed to by m_rows
         uint64 m_rowCount;
         uint64 m_rowPosition;
         uint32 m_fieldCount;
@@ -47,6 +47,20 @@ void Transaction::Append(PreparedStatement* stmt)
     m_queries.push_back(data);
 }
 
+size_t Transaction::GetDataSize() const
+{
+    size_t size = 0;
+    for (std::list<SQLElementData>::const_iterator itr = m_queries.begin(); itr != m_queries.end(); ++itr)
+    {
+        if (itr->type == SQL_ELEMENT_RAW)
+            size += strlen(itr->element.query);
+        else
+            size += itr->element.stmt->GetParametersSize();
+    }
+
+    return size;
+}
+
 void Transaction::Cleanup()
 {
     // This might be called by explicit calls to Cleanup or by the auto-destructor
@@ -38,6 +38,8 @@ class Transaction
         void PAppend(const char* sql, ...);
 
         size_t GetSize() const { return m_queries.size(); }
+        //- Query text of raw statements plus parameter data of prepared statements
+        size_t GetDataSize() const;
 
     protected:
         void Cleanup();
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ObjectPool.h"
+
+#include <new>
+
+enum ObjectPoolLimits
+{
+    OBJECT_POOL_SLAB_BLOCKS         = 64,                   // blocks carved from one heap allocation
+    OBJECT_POOL_TRANSFER_BLOCKS     = 32,                   // blocks moved between a thread list and the shared list at once
+    OBJECT_POOL_MAX_THREAD_BLOCKS   = 128                   // free blocks a thread keeps before handing some back
+};
+
+// blocks are 16 byte aligned, enough for any member of the pooled classes
+#define OBJECT_POOL_ALIGNMENT 16
+
+ObjectPool::FreeList::~FreeList()
+{
+    if (pool && count)
+        pool->Release(*this, count);
+}
+
+ObjectPool::ObjectPool(char const* name, size_t blockSize) : m_name(name),
+    m_blockSize((blockSize + OBJECT_POOL_ALIGNMENT - 1) & ~size_t(OBJECT_POOL_ALIGNMENT - 1)),
+    m_sharedHead(NULL), m_sharedCount(0), m_allocations(0), m_live(0), m_oversized(0)
+{
+    // pools are static members, so this runs during static initialization before any other thread exists
+    GetRegistry().push_back(this);
+}
+
+std::vector<ObjectPool*>& ObjectPool::GetRegistry()
+{
+    static std::vector<ObjectPool*> registry;
+    return registry;
+}
+
+void* ObjectPool::Allocate(size_t size)
+{
+    if (size > m_blockSize)
+    {
+        ++m_oversized;
+        return ::operator new(size);
+    }
+
+    FreeList* list = m_threadLists;
+    if (!list->head)
+    {
+        list->pool = this;
+        Refill(*list);
+    }
+
+    FreeBlock* block = list->head;
+    list->head = block->next;
+    --list->count;
+
+    ++m_allocations;
+    ++m_live;
+    return block;
+}
+
+void ObjectPool::Deallocate(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    if (size > m_blockSize)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    FreeList* list = m_threadLists;
+    list->pool = this;
+
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = list->head;
+    list->head = block;
+    ++list->count;
+    --m_live;
+
+    if (list->count > OBJECT_POOL_MAX_THREAD_BLOCKS)
+        Release(*list, OBJECT_POOL_TRANSFER_BLOCKS);
+}
+
+void ObjectPool::Refill(FreeList& list)
+{
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+
+    if (m_sharedCount)
+    {
+        // detach up to OBJECT_POOL_TRANSFER_BLOCKS blocks from the head of the shared list
+        FreeBlock* tail = m_sharedHead;
+        uint32 count = 1;
+        while (count < OBJECT_POOL_TRANSFER_BLOCKS && tail->next)
+        {
+            tail = tail->next;
+            ++count;
+        }
+
+        list.head = m_sharedHead;
+        list.count = count;
+        m_sharedHead = tail->next;
+        m_sharedCount -= count;
+        tail->next = NULL;
+        return;
+    }
+
+    char* slab = new char[m_blockSize * OBJECT_POOL_SLAB_BLOCKS];
+    m_slabs.push_back(slab);
+
+    for (uint32 i = OBJECT_POOL_SLAB_BLOCKS; i > 0; --i)
+    {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * m_blockSize);
+        block->next = list.head;
+        list.head = block;
+    }
+
+    list.count = OBJECT_POOL_SLAB_BLOCKS;
+}
+
+void ObjectPool::Release(FreeList& list, uint32 count)
+{
+    FreeBlock* head = list.head;
+    FreeBlock* tail = head;
+    for (uint32 i = 1; i < count; ++i)
+        tail = tail->next;
+
+    list.head = tail->next;
+    list.count -= count;
+
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    tail->next = m_sharedHead;
+    m_sharedHead = head;
+    m_sharedCount += count;
+}
+
+void ObjectPool::GetStats(Stats& stats) const
+{
+    stats.allocations = uint64(m_allocations.value());
+    stats.live = uint64(m_live.value() > 0 ? m_live.value() : 0);
+    stats.oversized = uint64(m_oversized.value());
+
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    stats.slabs = uint32(m_slabs.size());
+    stats.reserved = uint64(stats.slabs) * m_blockSize * OBJECT_POOL_SLAB_BLOCKS;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _OBJECT_POOL_H
+#define _OBJECT_POOL_H
+
+#include "Common.h"
+
+#include <ace/Atomic_Op.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/TSS_T.h>
+#include <vector>
+
+/*
+ * Fixed size block allocator for objects created and destroyed at a high rate
+ * (spells, auras). Blocks are carved from slabs and kept in a free list per
+ * thread, so map threads never contend with each other. A block freed by
+ * another thread than the one which allocated it simply joins the freeing
+ * thread's list; lists that grow too long hand blocks back to a shared list.
+ * Slabs are never released, objects may still be deleted by static destructors.
+ *
+ * A class uses a pool through a static member and class specific new/delete:
+ *     static ObjectPool Pool;
+ *     static void* operator new(size_t size) { return Pool.Allocate(size); }
+ *     static void operator delete(void* ptr, size_t size) { Pool.Deallocate(ptr, size); }
+ * The block size of a polymorphic class must fit its largest derived class,
+ * bigger requests are passed to the heap.
+ */
+class ObjectPool
+{
+    public:
+        struct Stats
+        {
+            uint64 allocations;
+            uint64 live;
+            uint64 oversized;                               // requests bigger than a block, served by the heap
+            uint32 slabs;
+            uint64 reserved;                                // bytes held by the slabs
+        };
+
+        ObjectPool(char const* name, size_t blockSize);
+
+        void* Allocate(size_t size);
+        void Deallocate(void* ptr, size_t size);
+
+        char const* GetName() const { return m_name; }
+        size_t GetBlockSize() const { return m_blockSize; }
+        void GetStats(Stats& stats) const;
+
+        // every pool of the process, in construction order
+        static std::vector<ObjectPool*> const& GetPools() { return GetRegistry(); }
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        struct FreeList
+        {
+            FreeList() : head(NULL), count(0), pool(NULL) {}
+            ~FreeList();
+
+            FreeBlock* head;
+            uint32 count;
+            ObjectPool* pool;
+        };
+
+        // refills an empty thread list from the shared list or a new slab
+        void Refill(FreeList& list);
+        // moves count blocks from the head of a thread list to the shared list
+        void Release(FreeList& list, uint32 count);
+
+        static std::vector<ObjectPool*>& GetRegistry();
+
+        char const* m_name;
+        size_t m_blockSize;
+
+        mutable ACE_Thread_Mutex m_lock;                    // protects the members below
+        FreeBlock* m_sharedHead;
+        uint32 m_sharedCount;
+        std::vector<char*> m_slabs;
+
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_allocations;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_live;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_oversized;
+
+        // declared last so the list of the destroying thread is handed back while the lock still exists
+        ACE_TSS<FreeList> m_threadLists;
+};
+
+#endif
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Profiler.h"
+#include "Timer.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/TSS_T.h>
+#include <vector>
+
+uint32 const ProfileEntry::BucketLimits[PROFILE_TIME_BUCKETS] = { 10, 50, 100, 500, 1000, 5000, 10000, 0xFFFFFFFF };
+
+void ProfileEntry::Add(uint32 time)
+{
+    ++count;
+    total += time;
+    if (time > max)
+        max = time;
+
+    uint8 bucket = 0;
+    while (time > BucketLimits[bucket])
+        ++bucket;
+
+    ++buckets[bucket];
+}
+
+void ProfileEntry::Merge(ProfileEntry const& other)
+{
+    if (name.empty())
+        name = other.name;
+
+    count += other.count;
+    total += other.total;
+    if (other.max > max)
+        max = other.max;
+
+    for (uint8 i = 0; i < PROFILE_TIME_BUCKETS; ++i)
+        buckets[i] += other.buckets[i];
+}
+
+typedef UNORDERED_MAP<uint64, ProfileEntry> ProfileEntryTable;
+
+struct ProfileThreadData;
+
+// tables of the running threads and what exited threads left behind
+struct ProfileRegistry
+{
+    ProfileRegistry() : windowStart(getMSTime()) {}
+
+    ACE_Thread_Mutex lock;                                  // protects the members below
+    std::vector<ProfileThreadData*> threads;
+    ProfileEntryTable retired;
+    uint32 windowStart;
+};
+
+// never destroyed, the table of the main thread is handed back after static destructors ran
+static ProfileRegistry& GetRegistry()
+{
+    static ProfileRegistry* registry = new ProfileRegistry();
+    return *registry;
+}
+
+struct ProfileThreadData
+{
+    ProfileThreadData()
+    {
+        ProfileRegistry& registry = GetRegistry();
+        SKYFIRE_GUARD(ACE_Thread_Mutex, registry.lock);
+        registry.threads.push_back(this);
+    }
+
+    ~ProfileThreadData()
+    {
+        ProfileRegistry& registry = GetRegistry();
+        SKYFIRE_GUARD(ACE_Thread_Mutex, registry.lock);
+        for (ProfileEntryTable::const_iterator itr = entries.begin(); itr != entries.end(); ++itr)
+            registry.retired[itr->first].Merge(itr->second);
+
+        for (std::vector<ProfileThreadData*>::iterator itr = registry.threads.begin(); itr != registry.threads.end(); ++itr)
+        {
+            if (*itr == this)
+            {
+                registry.threads.erase(itr);
+                break;
+            }
+        }
+    }
+
+    ACE_Thread_Mutex lock;                                  // only contended while collecting
+    ProfileEntryTable entries;
+};
+
+static ACE_TSS<ProfileThreadData> threadData;
+
+void Profiler::Record(ProfileCategory category, uint32 id, char const* name, uint32 time)
+{
+    ProfileThreadData* data = threadData;
+
+    SKYFIRE_GUARD(ACE_Thread_Mutex, data->lock);
+    ProfileEntry& entry = data->entries[(uint64(category) << 32) | id];
+    if (!entry.count)
+        entry.name = name;
+
+    entry.Add(time);
+}
+
+void Profiler::Collect(EntryMap& entries)
+{
+    ProfileRegistry& registry = GetRegistry();
+    SKYFIRE_GUARD(ACE_Thread_Mutex, registry.lock);
+
+    for (ProfileEntryTable::const_iterator itr = registry.retired.begin(); itr != registry.retired.end(); ++itr)
+        entries[itr->first].Merge(itr->second);
+
+    for (std::vector<ProfileThreadData*>::const_iterator thread = registry.threads.begin(); thread != registry.threads.end(); ++thread)
+    {
+        SKYFIRE_GUARD(ACE_Thread_Mutex, (*thread)->lock);
+        for (ProfileEntryTable::const_iterator itr = (*thread)->entries.begin(); itr != (*thread)->entries.end(); ++itr)
+            entries[itr->first].Merge(itr->second);
+    }
+}
+
+void Profiler::Reset()
+{
+    ProfileRegistry& registry = GetRegistry();
+    SKYFIRE_GUARD(ACE_Thread_Mutex, registry.lock);
+
+    registry.retired.clear();
+    for (std::vector<ProfileThreadData*>::const_iterator thread = registry.threads.begin(); thread != registry.threads.end(); ++thread)
+    {
+        SKYFIRE_GUARD(ACE_Thread_Mutex, (*thread)->lock);
+        (*thread)->entries.clear();
+    }
+
+    registry.windowStart = getMSTime();
+}
+
+uint32 Profiler::GetWindowStart()
+{
+    ProfileRegistry& registry = GetRegistry();
+    SKYFIRE_GUARD(ACE_Thread_Mutex, registry.lock);
+    return registry.windowStart;
+}
+
+char const* Profiler::GetCategoryName(ProfileCategory category)
+{
+    switch (category)
+    {
+        case PROFILE_OPCODE:        return "opcode";
+        case PROFILE_CREATURE_AI:   return "ai";
+        case PROFILE_SCRIPT_HOOK:   return "hook";
+        case PROFILE_PACKET_SIZE:   return "bytes";
+        case PROFILE_PACKET_THROTTLED: return "throttled";
+        default:                    return "unknown";
+    }
+}
+
+uint32 Profiler::HashName(char const* name)
+{
+    // FNV-1a
+    uint32 hash = 2166136261u;
+    for (; *name; ++name)
+        hash = (hash ^ uint8(*name)) * 16777619u;
+
+    return hash;
+}
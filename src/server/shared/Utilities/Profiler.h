@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PROFILER_H
+#define _PROFILER_H
+
+#include "Common.h"
+
+#include <ace/OS_NS_sys_time.h>
+#include <map>
+
+enum ProfileCategory
+{
+    PROFILE_OPCODE          = 0,                            // packet handlers, by opcode
+    PROFILE_CREATURE_AI     = 1,                            // CreatureAI::UpdateAI, by script or AI name
+    PROFILE_SCRIPT_HOOK     = 2,                            // ScriptMgr hooks, by hook
+    PROFILE_PACKET_SIZE     = 3,                            // received packets, by opcode, in bytes
+    PROFILE_PACKET_THROTTLED = 4,                           // packets dropped by the rate limits, by opcode, in bytes
+    MAX_PROFILE_CATEGORY
+};
+
+#define PROFILE_TIME_BUCKETS 8
+
+// CPU time spent in one profiled piece of code, in microseconds, or sizes (bytes) for the packet categories
+struct ProfileEntry
+{
+    ProfileEntry() : count(0), total(0), max(0)
+    {
+        memset(buckets, 0, sizeof(buckets));
+    }
+
+    void Add(uint32 time);
+    void Merge(ProfileEntry const& other);
+
+    // upper bound of each bucket, the last one takes everything above the previous limit
+    static uint32 const BucketLimits[PROFILE_TIME_BUCKETS];
+
+    std::string name;
+    uint64 count;
+    uint64 total;
+    uint32 max;
+    uint32 buckets[PROFILE_TIME_BUCKETS];
+};
+
+/*
+ * Always on accounting of where the CPU time of the world and map threads
+ * goes. Every thread records into its own table, so recording only takes an
+ * uncontended lock; Collect() merges the tables of all threads. The figures
+ * cover the window since the last Reset().
+ */
+class Profiler
+{
+    public:
+        // key is (category << 32) | id
+        typedef std::map<uint64, ProfileEntry> EntryMap;
+
+        static void Record(ProfileCategory category, uint32 id, char const* name, uint32 time);
+        static void Collect(EntryMap& entries);
+        static void Reset();
+
+        // getMSTime() of the last Reset()
+        static uint32 GetWindowStart();
+
+        static char const* GetCategoryName(ProfileCategory category);
+        static uint32 HashName(char const* name);
+};
+
+// measures the time until the end of the scope, optionally also adding it to a caller owned entry
+class ProfileScope
+{
+    public:
+        ProfileScope(ProfileCategory category, uint32 id, char const* name, ProfileEntry* local = NULL)
+            : m_category(category), m_id(id), m_name(name), m_local(local), m_start(ACE_OS::gettimeofday()) {}
+
+        ~ProfileScope()
+        {
+            ACE_UINT64 time;
+            (ACE_OS::gettimeofday() - m_start).to_usec(time);
+            Profiler::Record(m_category, m_id, m_name, uint32(time));
+            if (m_local)
+                m_local->Add(uint32(time));
+        }
+
+    private:
+        ProfileCategory m_category;
+        uint32 m_id;
+        char const* m_name;
+        ProfileEntry* m_local;
+        ACE_Time_Value m_start;
+};
+
+// profiles the rest of the enclosing function as a ScriptMgr hook
+#define PROFILE_SCRIPT_HOOK_SCOPE() \
+    static uint32 const profileHookId = Profiler::HashName(__FUNCTION__); \
+    ProfileScope profileScope(PROFILE_SCRIPT_HOOK, profileHookId, __FUNCTION__)
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TickArena.h"
+
+#include <ace/TSS_T.h>
+
+#define TICK_ARENA_CHUNK_SIZE   (64 * 1024)
+#define TICK_ARENA_ALIGNMENT    16
+
+struct TickArenaSlot
+{
+    TickArenaSlot() : arena(NULL) {}
+
+    TickArena* arena;
+};
+
+typedef ACE_TSS<TickArenaSlot> TickArenaTSS;
+static TickArenaTSS currentArena;
+
+TickArena::TickArena() : m_chunk(0), m_offset(0)
+{
+}
+
+TickArena::~TickArena()
+{
+    Reset();
+
+    for (std::vector<char*>::const_iterator itr = m_chunks.begin(); itr != m_chunks.end(); ++itr)
+        delete[] *itr;
+}
+
+void* TickArena::Allocate(size_t size)
+{
+    size = (size + TICK_ARENA_ALIGNMENT - 1) & ~size_t(TICK_ARENA_ALIGNMENT - 1);
+
+    if (size > TICK_ARENA_CHUNK_SIZE / 4)
+    {
+        char* block = new char[size];
+        m_largeBlocks.push_back(block);
+        return block;
+    }
+
+    if (m_chunks.empty() || m_offset + size > TICK_ARENA_CHUNK_SIZE)
+    {
+        // chunks kept from previous ticks are reused before allocating new ones
+        if (!m_chunks.empty())
+            ++m_chunk;
+
+        if (m_chunk >= m_chunks.size())
+            m_chunks.push_back(new char[TICK_ARENA_CHUNK_SIZE]);
+
+        m_offset = 0;
+    }
+
+    void* ptr = m_chunks[m_chunk] + m_offset;
+    m_offset += size;
+    return ptr;
+}
+
+void TickArena::Reset()
+{
+    for (std::vector<char*>::const_iterator itr = m_largeBlocks.begin(); itr != m_largeBlocks.end(); ++itr)
+        delete[] *itr;
+
+    m_largeBlocks.clear();
+    m_chunk = 0;
+    m_offset = 0;
+}
+
+TickArena* TickArena::Current()
+{
+    return currentArena->arena;
+}
+
+void TickArena::SetCurrent(TickArena* arena)
+{
+    currentArena->arena = arena;
+}
+
+TickArena::Scope::Scope(TickArena& arena) : m_arena(arena), m_previous(TickArena::Current())
+{
+    TickArena::SetCurrent(&arena);
+}
+
+TickArena::Scope::~Scope()
+{
+    TickArena::SetCurrent(m_previous);
+    m_arena.Reset();
+}
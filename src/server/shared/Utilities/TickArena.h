@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TICK_ARENA_H
+#define _TICK_ARENA_H
+
+#include "Define.h"
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/*
+ * Bump allocator for memory that does not outlive one update tick. Freeing is
+ * a no-op, everything is released at once by Reset(), which keeps the chunks
+ * for the next tick. An arena is only ever used by the thread that updates
+ * its owner: TickArena::Scope makes it the current arena of that thread and
+ * resets it when the tick ends.
+ */
+class TickArena
+{
+    public:
+        TickArena();
+        ~TickArena();
+
+        void* Allocate(size_t size);
+        void Reset();
+
+        // arena of the running tick of this thread, NULL outside of one
+        static TickArena* Current();
+
+        class Scope
+        {
+            public:
+                explicit Scope(TickArena& arena);
+                ~Scope();
+
+            private:
+                TickArena& m_arena;
+                TickArena* m_previous;
+        };
+
+    private:
+        TickArena(TickArena const&);
+        TickArena& operator=(TickArena const&);
+
+        static void SetCurrent(TickArena* arena);
+
+        std::vector<char*> m_chunks;                        // chunks of TICK_ARENA_CHUNK_SIZE bytes
+        std::vector<char*> m_largeBlocks;                   // bigger requests, freed on reset
+        size_t m_chunk;                                     // index of the chunk in use
+        size_t m_offset;                                    // first free byte in that chunk
+};
+
+/*
+ * STL allocator drawing from the arena that is current when the container is
+ * created, or from the heap when there is none. Containers using it must be
+ * destroyed before the tick ends, i.e. only locals of code run by the update.
+ */
+template<class T>
+class TickArenaAllocator
+{
+    public:
+        typedef T value_type;
+        typedef T* pointer;
+        typedef T const* const_pointer;
+        typedef T& reference;
+        typedef T const& const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        template<class U>
+        struct rebind
+        {
+            typedef TickArenaAllocator<U> other;
+        };
+
+        TickArenaAllocator() : m_arena(TickArena::Current()) {}
+        TickArenaAllocator(TickArenaAllocator const& right) : m_arena(right.m_arena) {}
+        template<class U>
+        TickArenaAllocator(TickArenaAllocator<U> const& right) : m_arena(right.GetArena()) {}
+
+        pointer address(reference value) const { return &value; }
+        const_pointer address(const_reference value) const { return &value; }
+
+        pointer allocate(size_type count, void const* /*hint*/ = 0)
+        {
+            if (m_arena)
+                return static_cast<pointer>(m_arena->Allocate(count * sizeof(T)));
+            return static_cast<pointer>(::operator new(count * sizeof(T)));
+        }
+
+        void deallocate(pointer ptr, size_type /*count*/)
+        {
+            if (!m_arena)
+                ::operator delete(ptr);
+        }
+
+        size_type max_size() const { return size_type(-1) / sizeof(T); }
+
+        void construct(pointer ptr, T const& value) { new (ptr) T(value); }
+        void destroy(pointer ptr) { ptr->~T(); }
+
+        TickArena* GetArena() const { return m_arena; }
+
+    private:
+        TickArena* m_arena;
+};
+
+template<class T, class U>
+inline bool operator==(TickArenaAllocator<T> const& left, TickArenaAllocator<U> const& right)
+{
+    return left.GetArena() == right.GetArena();
+}
+
+template<class T, class U>
+inline bool operator!=(TickArenaAllocator<T> const& left, TickArenaAllocator<U> const& right)
+{
+    return left.GetArena() != right.GetArena();
+}
+
+#endif
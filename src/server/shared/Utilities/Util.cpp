@@ -57,6 +57,11 @@ double rand_chance(void)
     return sfmtRand->Random() * 100.0;
 }
 
+void ReseedRandom(uint32 seed)
+{
+    sfmtRand->RandomInit(int(seed));
+}
+
 Tokens::Tokens(const std::string &src, const char sep, uint32 vectorReserve)
 {
     m_str = new char[src.length() + 1];
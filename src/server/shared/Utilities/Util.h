@@ -77,6 +77,9 @@ inline uint32 secsToTimeBitFields(time_t secs)
  * With an FPU, there is usually no difference in performance between float and double. */
  double rand_chance(void);
 
+/* Restart the random numbers of the calling thread from seed, used to make map captures replayable. */
+ void ReseedRandom(uint32 seed);
+
 /* Return true if a random roll fits in the specified chance (range 0-100). */
 inline bool roll_chance_f(float chance)
 {
@@ -60,6 +60,7 @@ void usage(const char *prog)
 {
     sLog->outString("Usage: \n %s [<options>]\n"
         "    -c config_file           use config_file as configuration file\n\r"
+        "    --replay capture_file    replay a map capture without network and exit\n\r"
         #ifdef _WIN32
         "    Running as service functions:\n\r"
         "    --service                run as service\n\r"
@@ -74,6 +75,7 @@ extern int main(int argc, char **argv)
 {
     ///- Command line parsing to get the configuration file name
     char const* cfg_file = _SKYFIRE_CORE_CONFIG;
+    char const* replay_file = NULL;
     int c = 1;
     while ( c < argc )
     {
@@ -89,6 +91,18 @@ extern int main(int argc, char **argv)
                 cfg_file = argv[c];
         }
 
+        if (strcmp(argv[c], "--replay") == 0)
+        {
+            if (++c >= argc)
+            {
+                sLog->outError("Runtime-Error: --replay option requires an input argument");
+                usage(argv[0]);
+                return 1;
+            }
+            else
+                replay_file = argv[c];
+        }
+
         #ifdef _WIN32
         ////////////
         //Services//
@@ -142,7 +156,7 @@ extern int main(int argc, char **argv)
 
     ///- and run the 'Master'
     /// \todo Why do we need this 'Master'? Can't all of this be in the Main as for Realmd?
-    int ret = sMaster->Run();
+    int ret = replay_file ? sMaster->Replay(replay_file) : sMaster->Run();
 
     // at sMaster return function exist with codes
     // 0 - normal shutdown
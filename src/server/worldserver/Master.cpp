@@ -40,6 +40,12 @@
 #include "Util.h"
 #include "AuthSocket.h"
 #include "BigNumber.h"
+#include "MapReplay.h"
+#include "ScriptMgr.h"
+#include "BattlegroundMgr.h"
+#include "MapManager.h"
+#include "ObjectAccessor.h"
+#include "OutdoorPvPMgr.h"
 
 #include <ace/Sig_Handler.h>
 
@@ -344,6 +350,37 @@ int Master::Run()
     return World::GetExitCode();
 }
 
+/// Replay a map capture as fast as the world can update, the realm stays offline
+int Master::Replay(char const* fileName)
+{
+    sLog->outString("%s (worldserver-daemon) replaying '%s'", _FULLVERSION, fileName);
+
+    if (!_StartDB())
+        return 1;
+
+    sWorld->SetInitialWorldSettings();
+    sScriptMgr->OnStartup();
+
+    // every captured player has to get in, a queued session is refused the character list
+    sWorld->SetPlayerAmountLimit(0);
+
+    int ret = sMapReplay->Run(fileName) ? 0 : 1;
+
+    // same teardown as the world thread
+    sScriptMgr->OnShutdown();
+    sWorld->KickAll();
+    sWorld->UpdateSessions(1);
+    sBattlegroundMgr->DeleteAllBattlegrounds();
+    sMapMgr->UnloadAll();
+    sObjectAccessor->UnloadAll();
+    sScriptMgr->Unload();
+    sOutdoorPvPMgr->Die();
+
+    ClearOnlineAccounts();
+    _StopDB();
+    return ret;
+}
+
 ///- Initialize connection to the databases
 bool Master::_StartDB()
 {
@@ -33,6 +33,8 @@ class Master
         Master();
         ~Master();
         int Run();
+        /// Run a map capture through the world without network, see MapReplay
+        int Replay(char const* fileName);
 
     private:
         bool _StartDB();
@@ -0,0 +1,316 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * client_swarm: logs a configurable number of scripted clients into a
+ * worldserver and reports the round trip times of their requests together
+ * with the map update times of the server while they play.
+ */
+
+#include "Common.h"
+#include "Configuration/Config.h"
+#include "Cryptography/SHA1.h"
+#include "Database/DatabaseEnv.h"
+#include "SignalHandler.h"
+#include "Timer.h"
+#include "Util.h"
+#include "SwarmWorker.h"
+
+#include <ace/Sig_Handler.h>
+
+#define SWARM_CONFIG        "client_swarm.conf"
+#define HIGHGUID_UNIT       0xF130                          // ObjectDefines.h
+
+LoginDatabaseWorkerPool LoginDatabase;                      // make the linker happy
+
+bool volatile stopEvent = false;
+
+class SwarmSignalHandler : public SkyFire::SignalHandler
+{
+public:
+    virtual void HandleSignal(int SigNum)
+    {
+        switch (SigNum)
+        {
+        case SIGINT:
+        case SIGTERM:
+            stopEvent = true;
+            break;
+        }
+    }
+};
+
+void usage(const char* prog)
+{
+    printf("Usage: \n %s [<options>]\n"
+        "    -c config_file           use config_file as configuration file\n"
+        "    --sql                    print the SQL creating the accounts of the bots and exit\n",
+        prog);
+}
+
+bool LoadConfig(SwarmConfig& config)
+{
+    config.authHost = ConfigMgr::GetStringDefault("Swarm.AuthHost", "127.0.0.1");
+    config.authPort = uint16(ConfigMgr::GetIntDefault("Swarm.AuthPort", 3724));
+    config.worldHost = ConfigMgr::GetStringDefault("Swarm.WorldHost", "127.0.0.1");
+    config.worldPort = uint16(ConfigMgr::GetIntDefault("Swarm.WorldPort", 8085));
+
+    config.accountPrefix = ConfigMgr::GetStringDefault("Swarm.AccountPrefix", "swarm");
+    config.password = ConfigMgr::GetStringDefault("Swarm.Password", "swarm");
+    config.namePrefix = ConfigMgr::GetStringDefault("Swarm.NamePrefix", "Sw");
+    config.firstAccount = uint32(ConfigMgr::GetIntDefault("Swarm.FirstAccount", 1));
+    config.bots = uint32(ConfigMgr::GetIntDefault("Swarm.Bots", 100));
+    config.race = uint8(ConfigMgr::GetIntDefault("Swarm.Race", 1));
+    config.playerClass = uint8(ConfigMgr::GetIntDefault("Swarm.Class", 1));
+
+    config.threads = uint32(ConfigMgr::GetIntDefault("Swarm.Threads", 4));
+    config.loginRate = uint32(ConfigMgr::GetIntDefault("Swarm.LoginRate", 10));
+    config.duration = uint32(ConfigMgr::GetIntDefault("Swarm.Duration", 300));
+    config.reportInterval = uint32(ConfigMgr::GetIntDefault("Swarm.ReportInterval", 10));
+    config.serverProfileFile = ConfigMgr::GetStringDefault("Swarm.ServerProfileFile", "");
+    config.reportFile = ConfigMgr::GetStringDefault("Swarm.ReportFile", "");
+
+    config.move = ConfigMgr::GetBoolDefault("Swarm.Move", true);
+    config.chatInterval = uint32(ConfigMgr::GetIntDefault("Swarm.ChatInterval", 20000));
+    config.chatLanguage = uint32(ConfigMgr::GetIntDefault("Swarm.ChatLanguage", 7));
+    config.castInterval = uint32(ConfigMgr::GetIntDefault("Swarm.CastInterval", 10000));
+    config.castSpell = uint32(ConfigMgr::GetIntDefault("Swarm.CastSpell", 0));
+    config.auctionInterval = uint32(ConfigMgr::GetIntDefault("Swarm.AuctionInterval", 60000));
+    config.whoInterval = uint32(ConfigMgr::GetIntDefault("Swarm.WhoInterval", 60000));
+
+    uint32 auctioneerGuid = uint32(ConfigMgr::GetIntDefault("Swarm.Auctioneer.Guid", 0));
+    uint32 auctioneerEntry = uint32(ConfigMgr::GetIntDefault("Swarm.Auctioneer.Entry", 0));
+    config.auctioneer = auctioneerGuid ? uint64(auctioneerGuid) | (uint64(auctioneerEntry) << 24) | (uint64(HIGHGUID_UNIT) << 48) : 0;
+
+    if (!config.bots || !config.threads)
+    {
+        printf("Swarm.Bots and Swarm.Threads must be at least 1.\n");
+        return false;
+    }
+
+    if (!config.reportInterval)
+        config.reportInterval = 10;
+
+    if (config.threads > config.bots)
+        config.threads = config.bots;
+
+    return true;
+}
+
+// accounts of the bots, the authserver only accepts existing ones
+void PrintAccountSql(SwarmConfig const& config)
+{
+    std::string password = config.password;
+    std::transform(password.begin(), password.end(), password.begin(), ::toupper);
+
+    for (uint32 i = 0; i < config.bots; ++i)
+    {
+        std::ostringstream account;
+        account << config.accountPrefix << (config.firstAccount + i);
+        std::string name = account.str();
+        std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+
+        SHA1Hash sha;
+        sha.UpdateData(name + ":" + password);
+        sha.Finalize();
+
+        std::string hash;
+        hexEncodeByteArray(sha.GetDigest(), sha.GetLength(), hash);
+
+        printf("INSERT INTO account (username, sha_pass_hash, expansion) VALUES ('%s', '%s', 3);\n", name.c_str(), hash.c_str());
+    }
+
+    printf("INSERT INTO realmcharacters (realmid, acctid, numchars) SELECT realmlist.id, account.id, 0 FROM realmlist, account LEFT JOIN realmcharacters ON acctid=account.id WHERE acctid IS NULL;\n");
+}
+
+void PrintCounters(SwarmCounters const& counters, uint32 seconds)
+{
+    printf("  network: sent %.1f packets/s %.1f KB/s, received %.1f packets/s %.1f KB/s, disconnects %u\n",
+        float(counters.packetsSent) / seconds, float(counters.bytesSent) / 1024 / seconds,
+        float(counters.packetsReceived) / seconds, float(counters.bytesReceived) / 1024 / seconds, counters.disconnects);
+
+    printf("  %-12s %8s %8s %8s %8s %8s %8s\n", "request", "count", "avg", "p50", "p99", "max", "timeouts");
+    for (uint8 i = 0; i < MAX_SWARM_REQUEST; ++i)
+    {
+        SwarmLatency const& latency = counters.latency[i];
+        if (!latency.count && !latency.timeouts)
+            continue;
+
+        printf("  %-12s %8u %8u %8u %8u %8u %8u\n", SwarmStats::GetRequestName(SwarmRequest(i)), latency.count,
+            latency.count ? uint32(latency.total / latency.count) : 0, latency.GetPercentile(50), latency.GetPercentile(99),
+            latency.max, latency.timeouts);
+    }
+}
+
+void WriteReportLine(std::string const& fileName, uint32 elapsed, uint32 const (&states)[MAX_BOT_STATE], SwarmCounters const& counters,
+    uint32 seconds, SwarmServerTicks const& ticks)
+{
+    FILE* file = fopen(fileName.c_str(), "a");
+    if (!file)
+        return;
+
+    // a header for new files, the columns are fixed so runs can be compared
+    fseek(file, 0, SEEK_END);
+    if (!ftell(file))
+    {
+        fprintf(file, "elapsed\tin_world\tlogging_in\tfailed\tsent_packets_s\treceived_packets_s\tdisconnects");
+        for (uint8 i = 0; i < MAX_SWARM_REQUEST; ++i)
+        {
+            std::string name = SwarmStats::GetRequestName(SwarmRequest(i));
+            std::replace(name.begin(), name.end(), ' ', '_');
+            fprintf(file, "\t%s_count\t%s_avg\t%s_p99\t%s_timeouts", name.c_str(), name.c_str(), name.c_str(), name.c_str());
+        }
+        fprintf(file, "\tmap_updates\tmap_update_avg\tmap_updates_slow\n");
+    }
+
+    fprintf(file, "%u\t%u\t%u\t%u\t%.1f\t%.1f\t%u", elapsed, states[BOT_STATE_IN_WORLD], states[BOT_STATE_LOGGING_IN],
+        states[BOT_STATE_FAILED], float(counters.packetsSent) / seconds, float(counters.packetsReceived) / seconds, counters.disconnects);
+
+    for (uint8 i = 0; i < MAX_SWARM_REQUEST; ++i)
+    {
+        SwarmLatency const& latency = counters.latency[i];
+        fprintf(file, "\t%u\t%u\t%u\t%u", latency.count, latency.count ? uint32(latency.total / latency.count) : 0,
+            latency.GetPercentile(99), latency.timeouts);
+    }
+
+    fprintf(file, "\t%u\t%.2f\t%u\n", ticks.ticks, ticks.ticks ? float(ticks.total) / ticks.ticks : 0.0f, ticks.slow);
+    fclose(file);
+}
+
+void Report(SwarmConfig const& config, SwarmStats& stats, uint32 elapsed)
+{
+    SwarmCounters counters;
+    stats.TakeInterval(counters);
+
+    uint32 states[MAX_BOT_STATE];
+    stats.GetBotStates(states);
+
+    printf("[%5us] bots: %u in world, %u logging in, %u waiting, %u failed\n", elapsed, states[BOT_STATE_IN_WORLD],
+        states[BOT_STATE_LOGGING_IN], states[BOT_STATE_WAITING], states[BOT_STATE_FAILED]);
+    PrintCounters(counters, config.reportInterval);
+
+    SwarmServerTicks ticks;
+    if (!config.serverProfileFile.empty())
+    {
+        if (!stats.ReadServerTicks(config.serverProfileFile, ticks))
+            printf("  server: can't read %s\n", config.serverProfileFile.c_str());
+        else if (ticks.dumps && ticks.ticks)
+            printf("  server: %u map updates, avg %.2f ms, %u over 50 ms\n", ticks.ticks, float(ticks.total) / ticks.ticks, ticks.slow);
+    }
+
+    if (!config.reportFile.empty())
+        WriteReportLine(config.reportFile, elapsed, states, counters, config.reportInterval, ticks);
+}
+
+int main(int argc, char** argv)
+{
+    char const* cfg_file = SWARM_CONFIG;
+    bool printSql = false;
+    for (int c = 1; c < argc; ++c)
+    {
+        if (strcmp(argv[c], "-c") == 0)
+        {
+            if (++c >= argc)
+            {
+                printf("Runtime-Error: -c option requires an input argument\n");
+                usage(argv[0]);
+                return 1;
+            }
+
+            cfg_file = argv[c];
+        }
+        else if (strcmp(argv[c], "--sql") == 0)
+            printSql = true;
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!ConfigMgr::Load(cfg_file))
+    {
+        printf("Invalid or missing configuration file : %s\n", cfg_file);
+        printf("Verify that the file exists and has \'[client_swarm]\' written in the top of the file!\n");
+        return 1;
+    }
+
+    SwarmConfig config;
+    if (!LoadConfig(config))
+        return 1;
+
+    if (printSql)
+    {
+        PrintAccountSql(config);
+        return 0;
+    }
+
+    printf("Starting %u bots in %u threads against %s:%u, <Ctrl-C> to stop.\n", config.bots, config.threads,
+        config.worldHost.c_str(), config.worldPort);
+
+    SwarmSignalHandler SignalINT, SignalTERM;
+    ACE_Sig_Handler Handler;
+    Handler.register_handler(SIGINT, &SignalINT);
+    Handler.register_handler(SIGTERM, &SignalTERM);
+
+    SwarmStats stats(config.bots);
+
+    std::vector<ACE_Based::Thread*> threads;
+    for (uint32 i = 0; i < config.threads; ++i)
+        threads.push_back(new ACE_Based::Thread(new SwarmWorker(i, config, stats, stopEvent)));
+
+    // the first report also swallows the server ticks from before the run
+    if (!config.serverProfileFile.empty())
+    {
+        SwarmServerTicks ticks;
+        stats.ReadServerTicks(config.serverProfileFile, ticks);
+    }
+
+    uint32 startTime = getMSTime();
+    uint32 nextReport = config.reportInterval;
+    while (!stopEvent)
+    {
+        ACE_Based::Thread::Sleep(100);
+
+        uint32 elapsed = GetMSTimeDiffToNow(startTime) / IN_MILLISECONDS;
+        if (elapsed >= nextReport)
+        {
+            Report(config, stats, elapsed);
+            nextReport += config.reportInterval;
+        }
+
+        if (config.duration && elapsed >= config.duration)
+            stopEvent = true;
+    }
+
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i]->wait();
+        delete threads[i];
+    }
+
+    uint32 elapsed = std::max<uint32>(1, GetMSTimeDiffToNow(startTime) / IN_MILLISECONDS);
+    uint32 states[MAX_BOT_STATE];
+    stats.GetBotStates(states);
+
+    printf("\nSummary of %u seconds: %u of %u bots in world at the end, %u failed\n", elapsed, states[BOT_STATE_IN_WORLD],
+        config.bots, states[BOT_STATE_FAILED]);
+    PrintCounters(stats.GetTotal(), elapsed);
+    return 0;
+}
@@ -0,0 +1,831 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SwarmBot.h"
+#include "Cryptography/HMACSHA1.h"
+#include "Cryptography/SHA1.h"
+#include "Timer.h"
+#include "Util.h"
+
+#include <ace/INET_Addr.h>
+#include <ace/SOCK_Connector.h>
+#include <ace/os_include/netinet/os_tcp.h>
+
+#define SWARM_CLIENT_BUILD      13623
+
+// opcodes of the 4.0.6a client used by the bots, values as in the game library's Opcodes.h
+enum SwarmOpcodes
+{
+    CMSG_CHAR_CREATE                = 0x07EEC,
+    CMSG_CHAR_ENUM                  = 0x06AA4,
+    SMSG_CHAR_CREATE                = 0x0F7EC,
+    SMSG_CHAR_ENUM                  = 0x0ECCC,
+    CMSG_PLAYER_LOGIN               = 0x08180,
+    CMSG_WHO                        = 0x0A4CC,
+    SMSG_WHO                        = 0x0BE8C,
+    CMSG_MESSAGECHAT_SAY            = 0x0002A,
+    SMSG_MESSAGECHAT                = 0x061E4,
+    MSG_MOVE_START_FORWARD          = 0x0EBAC,
+    MSG_MOVE_STOP                   = 0x034E0,
+    MSG_MOVE_SET_FACING             = 0x0ABC4,
+    MSG_MOVE_HEARTBEAT              = 0x022EC,
+    CMSG_CAST_SPELL                 = 0x065C4,
+    SMSG_CAST_FAILED                = 0x02A8C,
+    SMSG_SPELL_START                = 0x06BA8,
+    CMSG_PING                       = 0x0064E,
+    SMSG_PONG                       = 0x0A01B,
+    SMSG_AUTH_CHALLENGE             = 0x06019,
+    CMSG_AUTH_SESSION               = 0x00E0E,
+    SMSG_AUTH_RESPONSE              = 0x0B28C,
+    SMSG_LOGIN_VERIFY_WORLD         = 0x028C0,
+    CMSG_AUCTION_LIST_ITEMS         = 0x0E48C,
+    SMSG_AUCTION_LIST_RESULT        = 0x0E5A8,
+    SMSG_TIME_SYNC_REQ              = 0x0AA80,
+    CMSG_TIME_SYNC_RESP             = 0x0A8AC
+};
+
+// authserver commands, see AuthSocket.cpp
+enum SwarmAuthCmd
+{
+    AUTH_LOGON_CHALLENGE            = 0x00,
+    AUTH_LOGON_PROOF                = 0x01
+};
+
+enum SwarmAuthResponse
+{
+    AUTH_OK                         = 0x0C,
+    AUTH_WAIT_QUEUE                 = 0x1B
+};
+
+#define MOVEMENTFLAG_FORWARD        0x00000001
+
+#define SWARM_REQUEST_TIMEOUT       (10 * IN_MILLISECONDS)
+#define SWARM_NETWORK_TIMEOUT       10                      // seconds, realm login and world connect
+// the server kicks clients that ping more often than every 27 seconds
+#define SWARM_PING_INTERVAL         (30 * IN_MILLISECONDS)
+#define SWARM_HEARTBEAT_INTERVAL    500
+#define SWARM_MOVE_PAUSE            2000
+#define SWARM_RUN_SPEED             7.0f
+#define SWARM_PATH_LENGTH           20.0f                   // yards walked before turning around
+
+SwarmBot::SwarmBot(uint32 index, SwarmConfig const& config, SwarmStats& stats) : m_index(index), m_config(config),
+    m_stats(stats), m_state(BOT_STATE_WAITING), m_encrypt(SHA_DIGEST_LENGTH), m_decrypt(SHA_DIGEST_LENGTH), m_crypt(false),
+    m_headerRead(0), m_headerSize(4), m_charCreated(false), m_guid(0), m_mapId(0), m_x(0.0f), m_y(0.0f), m_z(0.0f),
+    m_orientation(0.0f), m_startX(0.0f), m_startY(0.0f), m_moving(false), m_lastMove(0), m_nextMove(0), m_nextPing(0),
+    m_nextChat(0), m_nextCast(0), m_nextAuction(0), m_nextWho(0), m_pingSequence(0), m_castCount(0)
+{
+    std::ostringstream account;
+    account << config.accountPrefix << (config.firstAccount + index);
+    m_account = account.str();
+    std::transform(m_account.begin(), m_account.end(), m_account.begin(), ::toupper);
+
+    memset(m_requestPending, 0, sizeof(m_requestPending));
+    memset(m_requestStart, 0, sizeof(m_requestStart));
+}
+
+SwarmBot::~SwarmBot()
+{
+    m_socket.close();
+}
+
+bool SwarmBot::Connect()
+{
+    SetState(BOT_STATE_LOGGING_IN);
+
+    uint32 start = getMSTime();
+    if (!RealmLogin(m_sessionKey))
+    {
+        Fail("realm login failed");
+        return false;
+    }
+
+    m_stats.AddLatency(SWARM_REQUEST_REALM_LOGIN, GetMSTimeDiffToNow(start));
+
+    StartRequest(SWARM_REQUEST_WORLD_LOGIN);
+
+    ACE_SOCK_Connector connector;
+    ACE_Time_Value timeout(SWARM_NETWORK_TIMEOUT);
+    if (connector.connect(m_socket, ACE_INET_Addr(m_config.worldPort, m_config.worldHost.c_str()), &timeout) == -1)
+    {
+        Fail("can't connect to the worldserver");
+        return false;
+    }
+
+    int noDelay = 1;
+    m_socket.set_option(ACE_IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    return true;
+}
+
+void SwarmBot::Disconnect()
+{
+    m_socket.close();
+}
+
+bool SwarmBot::RealmLogin(BigNumber& sessionKey)
+{
+    ACE_SOCK_Stream realm;
+    ACE_SOCK_Connector connector;
+    ACE_Time_Value timeout(SWARM_NETWORK_TIMEOUT);
+    if (connector.connect(realm, ACE_INET_Addr(m_config.authPort, m_config.authHost.c_str()), &timeout) == -1)
+        return false;
+
+    // sAuthLogonChallenge_C, strings are sent reversed
+    ByteBuffer challenge;
+    challenge << uint8(AUTH_LOGON_CHALLENGE);
+    challenge << uint8(8);
+    challenge << uint16(30 + m_account.size());
+    challenge.append("WoW", 4);
+    challenge << uint8(4) << uint8(0) << uint8(6);
+    challenge << uint16(SWARM_CLIENT_BUILD);
+    challenge.append("68x", 4);
+    challenge.append("niW", 4);
+    challenge.append("SUne", 4);
+    challenge << uint32(0);                                 // timezone bias
+    challenge << uint32(0x0100007F);                        // 127.0.0.1
+    challenge << uint8(m_account.size());
+    challenge.append(m_account.c_str(), m_account.size());
+
+    if (realm.send_n(challenge.contents(), challenge.size(), &timeout) != ssize_t(challenge.size()))
+    {
+        realm.close();
+        return false;
+    }
+
+    // cmd, unk, error, B, g length, g, N length, N, s, unk3, security flags
+    uint8 header[3];
+    uint8 B_bytes[32 + 1];
+    uint8 g_bytes[255 + 1];
+    uint8 N_bytes[255];
+    uint8 tail[32 + 16 + 1];
+    if (realm.recv_n(header, sizeof(header), &timeout) != sizeof(header) || header[2] != 0 ||
+        realm.recv_n(B_bytes, sizeof(B_bytes), &timeout) != sizeof(B_bytes) ||
+        realm.recv_n(g_bytes, B_bytes[32] + 1, &timeout) != B_bytes[32] + 1 ||
+        realm.recv_n(N_bytes, g_bytes[B_bytes[32]], &timeout) != g_bytes[B_bytes[32]] ||
+        realm.recv_n(tail, sizeof(tail), &timeout) != sizeof(tail) || tail[48] != 0)
+    {
+        // failed, or the account asks for a PIN, matrix or token
+        realm.close();
+        return false;
+    }
+
+    uint8 gLength = B_bytes[32];
+    uint8 NLength = g_bytes[gLength];
+    uint8* s_bytes = tail;
+
+    BigNumber N, g, s, B;
+    B.SetBinary(B_bytes, 32);
+    g.SetBinary(g_bytes, gLength);
+    N.SetBinary(N_bytes, NLength);
+    s.SetBinary(s_bytes, 32);
+
+    // x = SHA1(s, SHA1(ACCOUNT:PASSWORD)), the verifier the authserver derives from sha_pass_hash
+    std::string password = m_config.password;
+    std::transform(password.begin(), password.end(), password.begin(), ::toupper);
+
+    SHA1Hash sha;
+    sha.UpdateData(m_account + ":" + password);
+    sha.Finalize();
+    uint8 userHash[SHA_DIGEST_LENGTH];
+    memcpy(userHash, sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+    sha.Initialize();
+    sha.UpdateData(s_bytes, 32);
+    sha.UpdateData(userHash, SHA_DIGEST_LENGTH);
+    sha.Finalize();
+    BigNumber x;
+    x.SetBinary(sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+    BigNumber a;
+    a.SetRand(19 * 8);
+    BigNumber A = g.ModExp(a, N);
+
+    sha.Initialize();
+    sha.UpdateBigNumbers(&A, &B, NULL);
+    sha.Finalize();
+    BigNumber u;
+    u.SetBinary(sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+    // S = (B - 3 * g^x)^(a + u * x), 3 * N keeps the base positive
+    BigNumber k;
+    k.SetDword(3);
+    BigNumber gx = g.ModExp(x, N);
+    BigNumber base = (B + N * k - gx * k) % N;
+    BigNumber S = base.ModExp(a + u * x, N);
+
+    // session key, interleaved the same way as in AuthSocket::_HandleLogonProof
+    uint8 t[32];
+    uint8 t1[16];
+    uint8 vK[40];
+    memcpy(t, S.AsByteArray(32), 32);
+
+    for (int i = 0; i < 16; ++i)
+        t1[i] = t[i * 2];
+
+    sha.Initialize();
+    sha.UpdateData(t1, 16);
+    sha.Finalize();
+
+    for (int i = 0; i < 20; ++i)
+        vK[i * 2] = sha.GetDigest()[i];
+
+    for (int i = 0; i < 16; ++i)
+        t1[i] = t[i * 2 + 1];
+
+    sha.Initialize();
+    sha.UpdateData(t1, 16);
+    sha.Finalize();
+
+    for (int i = 0; i < 20; ++i)
+        vK[i * 2 + 1] = sha.GetDigest()[i];
+
+    sessionKey.SetBinary(vK, 40);
+
+    uint8 hash[SHA_DIGEST_LENGTH];
+    sha.Initialize();
+    sha.UpdateBigNumbers(&N, NULL);
+    sha.Finalize();
+    memcpy(hash, sha.GetDigest(), SHA_DIGEST_LENGTH);
+    sha.Initialize();
+    sha.UpdateBigNumbers(&g, NULL);
+    sha.Finalize();
+
+    for (int i = 0; i < SHA_DIGEST_LENGTH; ++i)
+        hash[i] ^= sha.GetDigest()[i];
+
+    BigNumber t3;
+    t3.SetBinary(hash, SHA_DIGEST_LENGTH);
+
+    sha.Initialize();
+    sha.UpdateData(m_account);
+    sha.Finalize();
+    uint8 t4[SHA_DIGEST_LENGTH];
+    memcpy(t4, sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+    sha.Initialize();
+    sha.UpdateBigNumbers(&t3, NULL);
+    sha.UpdateData(t4, SHA_DIGEST_LENGTH);
+    sha.UpdateBigNumbers(&s, &A, &B, &sessionKey, NULL);
+    sha.Finalize();
+    BigNumber M;
+    M.SetBinary(sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+    // sAuthLogonProof_C
+    ByteBuffer proof;
+    proof << uint8(AUTH_LOGON_PROOF);
+    proof.append(A.AsByteArray(32), 32);
+    proof.append(M.AsByteArray(SHA_DIGEST_LENGTH), SHA_DIGEST_LENGTH);
+    for (int i = 0; i < SHA_DIGEST_LENGTH; ++i)
+        proof << uint8(0);                                  // crc hash
+    proof << uint8(0);                                      // number of keys
+    proof << uint8(0);                                      // security flags
+
+    // sAuthLogonProof_S: cmd, error, M2, unk1, unk2, unk3
+    uint8 result[32];
+    if (realm.send_n(proof.contents(), proof.size(), &timeout) != ssize_t(proof.size()) ||
+        realm.recv_n(result, 2, &timeout) != 2 || result[1] != 0 ||
+        realm.recv_n(result + 2, sizeof(result) - 2, &timeout) != sizeof(result) - 2)
+    {
+        realm.close();
+        return false;
+    }
+
+    realm.close();
+
+    sha.Initialize();
+    sha.UpdateBigNumbers(&A, &M, &sessionKey, NULL);
+    sha.Finalize();
+    return memcmp(result + 2, sha.GetDigest(), SHA_DIGEST_LENGTH) == 0;
+}
+
+void SwarmBot::SendPacket(WorldPacket const& packet)
+{
+    // ClientPktHeader: size (big endian, covers the opcode) and opcode
+    uint8 header[6];
+    uint16 size = uint16(packet.size() + 4);
+    header[0] = uint8(size >> 8);
+    header[1] = uint8(size);
+    header[2] = uint8(packet.GetOpcode());
+    header[3] = uint8(packet.GetOpcode() >> 8);
+    header[4] = uint8(packet.GetOpcode() >> 16);
+    header[5] = uint8(packet.GetOpcode() >> 24);
+
+    if (m_crypt)
+        m_encrypt.UpdateData(sizeof(header), header);
+
+    iovec data[2];
+    data[0].iov_base = (char*)header;
+    data[0].iov_len = sizeof(header);
+    data[1].iov_base = packet.empty() ? NULL : (char*)packet.contents();
+    data[1].iov_len = packet.size();
+
+    ACE_Time_Value timeout(SWARM_NETWORK_TIMEOUT);
+    if (m_socket.sendv_n(data, packet.empty() ? 1 : 2, &timeout) != ssize_t(sizeof(header) + packet.size()))
+    {
+        Fail("send failed");
+        return;
+    }
+
+    m_stats.AddSent(uint32(sizeof(header) + packet.size()));
+}
+
+bool SwarmBot::HandleInput()
+{
+    char buffer[4096];
+    ssize_t received = m_socket.recv(buffer, sizeof(buffer));
+    if (received <= 0)
+    {
+        Fail("connection closed by the server");
+        return false;
+    }
+
+    m_input.insert(m_input.end(), buffer, buffer + received);
+
+    size_t pos = 0;
+    while (m_state != BOT_STATE_FAILED)
+    {
+        // ServerPktHeader: size (big endian, covers the opcode, 3 bytes if the first has 0x80 set) and opcode
+        while (m_headerRead < m_headerSize && pos < m_input.size())
+        {
+            uint8 byte = m_input[pos++];
+            if (m_crypt)
+                m_decrypt.UpdateData(1, &byte);
+
+            if (m_headerRead == 0 && (byte & 0x80))
+                m_headerSize = 5;
+
+            m_header[m_headerRead++] = byte;
+        }
+
+        if (m_headerRead < m_headerSize)
+            break;
+
+        uint32 size = m_headerSize == 5 ? (uint32(m_header[0] & 0x7F) << 16) | (m_header[1] << 8) | m_header[2] : (m_header[0] << 8) | m_header[1];
+        uint8 const* opcode = m_header + m_headerSize - 2;
+        size_t payload = size >= 2 ? size - 2 : 0;
+        if (m_input.size() - pos < payload)
+            break;
+
+        WorldPacket packet(opcode[0] | (opcode[1] << 8), payload);
+        if (payload)
+            packet.append(&m_input[pos], payload);
+
+        pos += payload;
+        m_stats.AddReceived(uint32(m_headerSize + payload));
+        m_headerRead = 0;
+        m_headerSize = 4;
+
+        try
+        {
+            HandlePacket(packet);
+        }
+        catch (ByteBufferException &)
+        {
+            Fail("malformed packet");
+        }
+    }
+
+    m_input.erase(m_input.begin(), m_input.begin() + pos);
+    return m_state != BOT_STATE_FAILED;
+}
+
+void SwarmBot::HandlePacket(WorldPacket& packet)
+{
+    switch (packet.GetOpcode())
+    {
+        case SMSG_AUTH_CHALLENGE:
+            HandleAuthChallenge(packet);
+            break;
+        case SMSG_AUTH_RESPONSE:
+            HandleAuthResponse(packet);
+            break;
+        case SMSG_CHAR_ENUM:
+            HandleCharEnum(packet);
+            break;
+        case SMSG_CHAR_CREATE:
+        {
+            // the result code is checked by listing the characters again
+            WorldPacket data(CMSG_CHAR_ENUM, 0);
+            SendPacket(data);
+            break;
+        }
+        case SMSG_LOGIN_VERIFY_WORLD:
+            HandleLoginVerifyWorld(packet);
+            break;
+        case SMSG_TIME_SYNC_REQ:
+            HandleTimeSyncRequest(packet);
+            break;
+        case SMSG_PONG:
+            FinishRequest(SWARM_REQUEST_PING);
+            break;
+        case SMSG_MESSAGECHAT:
+            HandleMessageChat(packet);
+            break;
+        case SMSG_SPELL_START:
+        {
+            // other bots casting nearby are seen too
+            uint64 castItemOrCaster, caster;
+            packet.readPackGUID(castItemOrCaster);
+            packet.readPackGUID(caster);
+            if (caster == m_guid)
+                FinishRequest(SWARM_REQUEST_CAST);
+            break;
+        }
+        case SMSG_CAST_FAILED:
+            FinishRequest(SWARM_REQUEST_CAST);
+            break;
+        case SMSG_AUCTION_LIST_RESULT:
+            FinishRequest(SWARM_REQUEST_AUCTION);
+            break;
+        case SMSG_WHO:
+            FinishRequest(SWARM_REQUEST_WHO);
+            break;
+        default:
+            break;
+    }
+}
+
+void SwarmBot::HandleAuthChallenge(WorldPacket& packet)
+{
+    uint32 serverSeed;
+    packet.read_skip(16);
+    packet.read_skip<uint8>();
+    packet >> serverSeed;
+
+    uint32 clientSeed = uint32(rand32());
+    uint32 unk = 0;
+
+    SHA1Hash sha;
+    sha.UpdateData(m_account);
+    sha.UpdateData((uint8*)&unk, 4);
+    sha.UpdateData((uint8*)&clientSeed, 4);
+    sha.UpdateData((uint8*)&serverSeed, 4);
+    sha.UpdateBigNumbers(&m_sessionKey, NULL);
+    sha.Finalize();
+    uint8 const* digest = sha.GetDigest();
+
+    // field order of WorldSocket::HandleAuthSession, the digest is spread over the packet
+    WorldPacket data(CMSG_AUTH_SESSION, 60 + m_account.size());
+    data.append(digest, 7);
+    data << uint32(0);
+    data.append(digest + 7, 1);
+    data << uint64(0);
+    data << uint32(0);
+    data.append(digest + 8, 1);
+    data << uint8(0);
+    data.append(digest + 9, 2);
+    data << uint32(clientSeed);
+    data << uint32(0);
+    data.append(digest + 11, 6);
+    data << uint16(SWARM_CLIENT_BUILD);
+    data.append(digest + 17, 1);
+    data << uint8(0);
+    data << uint32(0);
+    data.append(digest + 18, 2);
+    data << uint32(0);                                      // addon info size
+    data << m_account;
+    SendPacket(data);
+
+    // the opposite keys of AuthCrypt::Init
+    uint8 encryptSeed[SEED_KEY_SIZE] = { 0xC2, 0xB3, 0x72, 0x3C, 0xC6, 0xAE, 0xD9, 0xB5, 0x34, 0x3C, 0x53, 0xEE, 0x2F, 0x43, 0x67, 0xCE };
+    uint8 decryptSeed[SEED_KEY_SIZE] = { 0xCC, 0x98, 0xAE, 0x04, 0xE8, 0x97, 0xEA, 0xCA, 0x12, 0xDD, 0xC0, 0x93, 0x42, 0x91, 0x53, 0x57 };
+    HmacHash encryptHmac(SEED_KEY_SIZE, encryptSeed);
+    HmacHash decryptHmac(SEED_KEY_SIZE, decryptSeed);
+    m_encrypt.Init(encryptHmac.ComputeHash(&m_sessionKey));
+    m_decrypt.Init(decryptHmac.ComputeHash(&m_sessionKey));
+
+    // ARC4-drop1024
+    uint8 syncBuf[1024];
+    memset(syncBuf, 0, sizeof(syncBuf));
+    m_encrypt.UpdateData(sizeof(syncBuf), syncBuf);
+    memset(syncBuf, 0, sizeof(syncBuf));
+    m_decrypt.UpdateData(sizeof(syncBuf), syncBuf);
+
+    m_crypt = true;
+}
+
+void SwarmBot::HandleAuthResponse(WorldPacket& packet)
+{
+    uint8 code;
+    packet >> code;
+
+    // still queued, the server sends AUTH_OK when the queue lets us in
+    if (code == AUTH_WAIT_QUEUE)
+        return;
+
+    if (code != AUTH_OK)
+    {
+        Fail("world login refused");
+        return;
+    }
+
+    FinishRequest(SWARM_REQUEST_WORLD_LOGIN);
+
+    WorldPacket data(CMSG_CHAR_ENUM, 0);
+    SendPacket(data);
+}
+
+void SwarmBot::HandleCharEnum(WorldPacket& packet)
+{
+    uint8 count;
+    packet >> count;
+
+    if (count)
+    {
+        packet >> m_guid;
+
+        StartRequest(SWARM_REQUEST_ENTER_WORLD);
+        WorldPacket data(CMSG_PLAYER_LOGIN, 8);
+        data << uint64(m_guid);
+        SendPacket(data);
+        return;
+    }
+
+    if (m_charCreated)
+    {
+        Fail("character creation failed");
+        return;
+    }
+
+    // names are letters only: the prefix and the bot index spelled as syllables
+    static char const consonants[] = "bcdfghjklmnprstvwxyz";
+    static char const vowels[] = "aeiou";
+    std::string name = m_config.namePrefix;
+    for (uint32 index = m_config.firstAccount + m_index, i = 0; i < 4; ++i, index /= 20)
+    {
+        name += consonants[index % 20];
+        name += vowels[(index / 20 + i) % 5];
+    }
+
+    m_charCreated = true;
+
+    WorldPacket data(CMSG_CHAR_CREATE, name.size() + 1 + 9);
+    data << name;
+    data << uint8(m_config.race);
+    data << uint8(m_config.playerClass);
+    data << uint8(0);                                       // gender
+    data << uint8(0) << uint8(0);                           // skin, face
+    data << uint8(0) << uint8(0) << uint8(0);               // hair style, hair color, facial hair
+    data << uint8(0);                                       // outfit
+    SendPacket(data);
+}
+
+void SwarmBot::HandleLoginVerifyWorld(WorldPacket& packet)
+{
+    packet >> m_mapId >> m_x >> m_y >> m_z >> m_orientation;
+    m_startX = m_x;
+    m_startY = m_y;
+
+    FinishRequest(SWARM_REQUEST_ENTER_WORLD);
+    SetState(BOT_STATE_IN_WORLD);
+
+    uint32 now = getMSTime();
+    m_nextMove = NextActionTime(now, SWARM_MOVE_PAUSE);
+    m_nextPing = NextActionTime(now, SWARM_PING_INTERVAL);
+    m_nextChat = NextActionTime(now, m_config.chatInterval);
+    m_nextCast = NextActionTime(now, m_config.castInterval);
+    m_nextAuction = NextActionTime(now, m_config.auctionInterval);
+    m_nextWho = NextActionTime(now, m_config.whoInterval);
+}
+
+void SwarmBot::HandleMessageChat(WorldPacket& packet)
+{
+    uint8 type;
+    uint32 language;
+    uint64 sender;
+    packet >> type >> language >> sender;
+
+    if (sender == m_guid)
+        FinishRequest(SWARM_REQUEST_CHAT);
+}
+
+void SwarmBot::HandleTimeSyncRequest(WorldPacket& packet)
+{
+    uint32 counter;
+    packet >> counter;
+
+    WorldPacket data(CMSG_TIME_SYNC_RESP, 8);
+    data << uint32(counter);
+    data << uint32(getMSTime());
+    SendPacket(data);
+}
+
+void SwarmBot::Update(uint32 now)
+{
+    for (uint8 i = 0; i < MAX_SWARM_REQUEST; ++i)
+    {
+        if (m_requestPending[i] && getMSTimeDiff(m_requestStart[i], now) > SWARM_REQUEST_TIMEOUT)
+        {
+            m_requestPending[i] = false;
+            m_stats.AddTimeout(SwarmRequest(i));
+        }
+    }
+
+    if (m_state != BOT_STATE_IN_WORLD)
+        return;
+
+    UpdateMovement(now);
+
+    if (now >= m_nextPing)
+        SendPing(now);
+
+    if (m_config.chatInterval && now >= m_nextChat)
+        SendChat(now);
+
+    if (m_config.castInterval && m_config.castSpell && now >= m_nextCast)
+        SendCast(now);
+
+    if (m_config.auctionInterval && m_config.auctioneer && now >= m_nextAuction)
+        SendAuctionSearch(now);
+
+    if (m_config.whoInterval && now >= m_nextWho)
+        SendWho(now);
+}
+
+void SwarmBot::UpdateMovement(uint32 now)
+{
+    if (!m_config.move || now < m_nextMove)
+        return;
+
+    if (!m_moving)
+    {
+        m_moving = true;
+        m_lastMove = now;
+        m_nextMove = now + SWARM_HEARTBEAT_INTERVAL;
+        SendMovement(MSG_MOVE_START_FORWARD, MOVEMENTFLAG_FORWARD, now);
+        return;
+    }
+
+    float distance = SWARM_RUN_SPEED * getMSTimeDiff(m_lastMove, now) / IN_MILLISECONDS;
+    m_x += distance * cos(m_orientation);
+    m_y += distance * sin(m_orientation);
+    m_lastMove = now;
+
+    float dx = m_x - m_startX;
+    float dy = m_y - m_startY;
+    if (dx * dx + dy * dy < SWARM_PATH_LENGTH * SWARM_PATH_LENGTH)
+    {
+        m_nextMove = now + SWARM_HEARTBEAT_INTERVAL;
+        SendMovement(MSG_MOVE_HEARTBEAT, MOVEMENTFLAG_FORWARD, now);
+        return;
+    }
+
+    // end of the path, turn around and walk back after a pause
+    SendMovement(MSG_MOVE_STOP, 0, now);
+    m_orientation = fmod(m_orientation + float(M_PI), float(2 * M_PI));
+    SendMovement(MSG_MOVE_SET_FACING, 0, now);
+
+    m_startX = m_x;
+    m_startY = m_y;
+    m_moving = false;
+    m_nextMove = now + SWARM_MOVE_PAUSE;
+}
+
+void SwarmBot::SendMovement(uint32 opcode, uint32 flags, uint32 now)
+{
+    // read by WorldSession::ReadMovementInfo, no transport, pitch or fall data
+    WorldPacket data(opcode, 8 + 4 + 2 + 4 + 4 * 4);
+    data.appendPackGUID(m_guid);
+    data << uint32(flags);
+    data << uint16(0);
+    data << uint32(now);
+    data << m_x << m_y << m_z << m_orientation;
+    SendPacket(data);
+}
+
+void SwarmBot::SendPing(uint32 now)
+{
+    m_nextPing = now + SWARM_PING_INTERVAL;
+    if (!StartRequest(SWARM_REQUEST_PING))
+        return;
+
+    WorldPacket data(CMSG_PING, 8);
+    data << uint32(0);                                      // latency
+    data << uint32(++m_pingSequence);
+    SendPacket(data);
+}
+
+void SwarmBot::SendChat(uint32 now)
+{
+    m_nextChat = NextActionTime(now, m_config.chatInterval);
+    if (!StartRequest(SWARM_REQUEST_CHAT))
+        return;
+
+    std::ostringstream message;
+    message << "swarm bot " << m_index << " at " << now;
+
+    WorldPacket data(CMSG_MESSAGECHAT_SAY, 4 + message.str().size() + 1);
+    data << uint32(m_config.chatLanguage);
+    data << message.str();
+    SendPacket(data);
+}
+
+void SwarmBot::SendCast(uint32 now)
+{
+    m_nextCast = NextActionTime(now, m_config.castInterval);
+    if (!StartRequest(SWARM_REQUEST_CAST))
+        return;
+
+    WorldPacket data(CMSG_CAST_SPELL, 1 + 4 + 4 + 1 + 4);
+    data << uint8(++m_castCount);
+    data << uint32(m_config.castSpell);
+    data << uint32(0);                                      // glyph index
+    data << uint8(0);                                       // cast flags
+    data << uint32(0);                                      // target mask, self
+    SendPacket(data);
+}
+
+void SwarmBot::SendAuctionSearch(uint32 now)
+{
+    m_nextAuction = NextActionTime(now, m_config.auctionInterval);
+    if (!StartRequest(SWARM_REQUEST_AUCTION))
+        return;
+
+    // the server only answers when the auctioneer is in interaction range
+    WorldPacket data(CMSG_AUCTION_LIST_ITEMS, 8 + 4 + 1 + 2 + 12 + 5 + 2);
+    data << uint64(m_config.auctioneer);
+    data << uint32(0);                                      // list from
+    data << std::string();                                  // searched name
+    data << uint8(0) << uint8(0);                           // level min, max
+    data << uint32(0xFFFFFFFF) << uint32(0xFFFFFFFF) << uint32(0xFFFFFFFF); // slot, class, subclass
+    data << uint32(0xFFFFFFFF) << uint8(0);                 // quality, usable
+    data << uint8(0);
+    data << uint8(0);                                       // sort columns
+    SendPacket(data);
+}
+
+void SwarmBot::SendWho(uint32 now)
+{
+    m_nextWho = NextActionTime(now, m_config.whoInterval);
+    if (!StartRequest(SWARM_REQUEST_WHO))
+        return;
+
+    WorldPacket data(CMSG_WHO, 4 * 6 + 2);
+    data << uint32(0) << uint32(100);                       // level min, max
+    data << std::string() << std::string();                 // player, guild name
+    data << uint32(0xFFFFFFFF) << uint32(0xFFFFFFFF);       // race, class mask
+    data << uint32(0);                                      // zones
+    data << uint32(0);                                      // strings
+    SendPacket(data);
+}
+
+bool SwarmBot::StartRequest(SwarmRequest request)
+{
+    if (m_requestPending[request])
+        return false;
+
+    m_requestPending[request] = true;
+    m_requestStart[request] = getMSTime();
+    return true;
+}
+
+void SwarmBot::FinishRequest(SwarmRequest request)
+{
+    if (!m_requestPending[request])
+        return;
+
+    m_requestPending[request] = false;
+    m_stats.AddLatency(request, GetMSTimeDiffToNow(m_requestStart[request]));
+}
+
+uint32 SwarmBot::NextActionTime(uint32 now, uint32 interval)
+{
+    return now + interval / 2 + urand(0, interval);
+}
+
+void SwarmBot::SetState(SwarmBotState state)
+{
+    if (state == m_state)
+        return;
+
+    m_stats.ChangeBotState(m_state, state);
+    m_state = state;
+}
+
+void SwarmBot::Fail(char const* reason)
+{
+    if (m_state == BOT_STATE_FAILED)
+        return;
+
+    if (m_state == BOT_STATE_IN_WORLD)
+        m_stats.AddDisconnect();
+
+    printf("Bot %u (%s): %s.\n", m_index, m_account.c_str(), reason);
+    SetState(BOT_STATE_FAILED);
+    m_socket.close();
+}
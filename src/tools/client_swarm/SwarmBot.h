@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SWARM_BOT_H
+#define _SWARM_BOT_H
+
+#include "Common.h"
+#include "SwarmStats.h"
+#include "WorldPacket.h"
+#include "Cryptography/ARC4.h"
+#include "Cryptography/BigNumber.h"
+
+#include <ace/SOCK_Stream.h>
+
+// settings of the run, see client_swarm.conf.dist
+struct SwarmConfig
+{
+    std::string authHost;
+    uint16 authPort;
+    std::string worldHost;
+    uint16 worldPort;
+
+    std::string accountPrefix;
+    std::string password;
+    std::string namePrefix;
+    uint32 firstAccount;
+    uint32 bots;
+    uint8 race;
+    uint8 playerClass;
+
+    uint32 threads;
+    uint32 loginRate;                                       // bots started per second
+    uint32 duration;                                        // seconds, 0 runs until interrupted
+    uint32 reportInterval;                                  // seconds
+    std::string serverProfileFile;
+    std::string reportFile;
+
+    bool move;
+    uint32 chatInterval;                                    // milliseconds, 0 disables the action
+    uint32 chatLanguage;
+    uint32 castInterval;
+    uint32 castSpell;
+    uint32 auctionInterval;
+    uint64 auctioneer;
+    uint32 whoInterval;
+};
+
+/*
+ * One scripted client: logs in through the authserver (SRP6), opens a world
+ * session (CMSG_AUTH_SESSION and the ARC4 header crypt), creates a character
+ * if the account has none, enters the world and then moves, chats, casts and
+ * searches as configured. Speaks the 4.0.6a (13623) protocol of this server.
+ */
+class SwarmBot
+{
+    public:
+        SwarmBot(uint32 index, SwarmConfig const& config, SwarmStats& stats);
+        ~SwarmBot();
+
+        // realm login and world connection, blocks until the world socket is open
+        bool Connect();
+        void Disconnect();
+
+        ACE_HANDLE GetHandle() const { return m_socket.get_handle(); }
+        SwarmBotState GetState() const { return m_state; }
+
+        // reads what the server sent, false if the connection is gone
+        bool HandleInput();
+        // runs the script and expires unanswered requests
+        void Update(uint32 now);
+
+    private:
+        bool RealmLogin(BigNumber& sessionKey);
+
+        void SendPacket(WorldPacket const& packet);
+        void HandlePacket(WorldPacket& packet);
+
+        void HandleAuthChallenge(WorldPacket& packet);
+        void HandleAuthResponse(WorldPacket& packet);
+        void HandleCharEnum(WorldPacket& packet);
+        void HandleLoginVerifyWorld(WorldPacket& packet);
+        void HandleMessageChat(WorldPacket& packet);
+        void HandleTimeSyncRequest(WorldPacket& packet);
+
+        void UpdateMovement(uint32 now);
+        void SendMovement(uint32 opcode, uint32 flags, uint32 now);
+        void SendPing(uint32 now);
+        void SendChat(uint32 now);
+        void SendCast(uint32 now);
+        void SendAuctionSearch(uint32 now);
+        void SendWho(uint32 now);
+
+        // starts the round trip clock of a request, false if one is still unanswered
+        bool StartRequest(SwarmRequest request);
+        void FinishRequest(SwarmRequest request);
+        // next time of an action, spread so the bots don't act in lockstep
+        static uint32 NextActionTime(uint32 now, uint32 interval);
+
+        void SetState(SwarmBotState state);
+        void Fail(char const* reason);
+
+        uint32 m_index;
+        std::string m_account;
+        SwarmConfig const& m_config;
+        SwarmStats& m_stats;
+        SwarmBotState m_state;
+
+        ACE_SOCK_Stream m_socket;
+        BigNumber m_sessionKey;
+        ARC4 m_encrypt;
+        ARC4 m_decrypt;
+        bool m_crypt;                                       // headers are encrypted after CMSG_AUTH_SESSION
+
+        std::vector<uint8> m_input;                         // received, not yet handled bytes
+        uint8 m_header[5];                                  // decrypted header of the next packet
+        uint8 m_headerRead;
+        uint8 m_headerSize;                                 // 5 for packets with the large size flag
+
+        bool m_charCreated;
+        uint64 m_guid;
+        uint32 m_mapId;
+        float m_x, m_y, m_z, m_orientation;
+        float m_startX, m_startY;
+
+        bool m_requestPending[MAX_SWARM_REQUEST];
+        uint32 m_requestStart[MAX_SWARM_REQUEST];
+
+        bool m_moving;
+        uint32 m_lastMove;
+        uint32 m_nextMove;                                  // next start or heartbeat
+        uint32 m_nextPing;
+        uint32 m_nextChat;
+        uint32 m_nextCast;
+        uint32 m_nextAuction;
+        uint32 m_nextWho;
+        uint32 m_pingSequence;
+        uint8 m_castCount;
+};
+
+#endif
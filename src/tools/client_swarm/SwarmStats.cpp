@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SwarmStats.h"
+
+#include <ace/Guard_T.h>
+
+// number of map update time buckets in the profile dump, see MapUpdateStats
+#define SERVER_TICK_BUCKETS     8
+// first bucket of the map updates over 50 ms
+#define SERVER_TICK_SLOW_BUCKET 4
+
+uint32 const SwarmLatency::BucketLimits[SWARM_LATENCY_BUCKETS] = { 1, 5, 10, 50, 100, 500, 1000, 0xFFFFFFFF };
+
+void SwarmLatency::Add(uint32 time)
+{
+    ++count;
+    total += time;
+    if (time > max)
+        max = time;
+
+    uint8 bucket = 0;
+    while (time > BucketLimits[bucket])
+        ++bucket;
+
+    ++buckets[bucket];
+}
+
+void SwarmLatency::Merge(SwarmLatency const& other)
+{
+    count += other.count;
+    timeouts += other.timeouts;
+    total += other.total;
+    if (other.max > max)
+        max = other.max;
+
+    for (uint8 i = 0; i < SWARM_LATENCY_BUCKETS; ++i)
+        buckets[i] += other.buckets[i];
+}
+
+uint32 SwarmLatency::GetPercentile(uint32 percent) const
+{
+    uint64 wanted = (uint64(count) * percent + 99) / 100;
+    uint64 seen = 0;
+    for (uint8 i = 0; i < SWARM_LATENCY_BUCKETS - 1; ++i)
+    {
+        seen += buckets[i];
+        if (seen >= wanted)
+            return std::min(BucketLimits[i], max);
+    }
+
+    return max;
+}
+
+void SwarmCounters::Merge(SwarmCounters const& other)
+{
+    packetsSent += other.packetsSent;
+    bytesSent += other.bytesSent;
+    packetsReceived += other.packetsReceived;
+    bytesReceived += other.bytesReceived;
+    disconnects += other.disconnects;
+
+    for (uint8 i = 0; i < MAX_SWARM_REQUEST; ++i)
+        latency[i].Merge(other.latency[i]);
+}
+
+SwarmStats::SwarmStats(uint32 bots)
+{
+    memset(m_botStates, 0, sizeof(m_botStates));
+    m_botStates[BOT_STATE_WAITING] = bots;
+}
+
+void SwarmStats::AddLatency(SwarmRequest request, uint32 time)
+{
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    m_interval.latency[request].Add(time);
+}
+
+void SwarmStats::AddTimeout(SwarmRequest request)
+{
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    ++m_interval.latency[request].timeouts;
+}
+
+void SwarmStats::AddSent(uint32 bytes)
+{
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    ++m_interval.packetsSent;
+    m_interval.bytesSent += bytes;
+}
+
+void SwarmStats::AddReceived(uint32 bytes)
+{
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    ++m_interval.packetsReceived;
+    m_interval.bytesReceived += bytes;
+}
+
+void SwarmStats::AddDisconnect()
+{
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    ++m_interval.disconnects;
+}
+
+void SwarmStats::ChangeBotState(SwarmBotState from, SwarmBotState to)
+{
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    --m_botStates[from];
+    ++m_botStates[to];
+}
+
+void SwarmStats::TakeInterval(SwarmCounters& counters)
+{
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    counters = m_interval;
+    m_total.Merge(m_interval);
+    m_interval = SwarmCounters();
+}
+
+SwarmCounters SwarmStats::GetTotal()
+{
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    SwarmCounters total = m_total;
+    total.Merge(m_interval);
+    return total;
+}
+
+void SwarmStats::GetBotStates(uint32 (&states)[MAX_BOT_STATE])
+{
+    SKYFIRE_GUARD(ACE_Thread_Mutex, m_lock);
+    memcpy(states, m_botStates, sizeof(states));
+}
+
+bool SwarmStats::ReadServerTicks(std::string const& fileName, SwarmServerTicks& ticks)
+{
+    ticks = SwarmServerTicks();
+
+    FILE* file = fopen(fileName.c_str(), "r");
+    if (!file)
+        return false;
+
+    char line[1024];
+    MapTicksMap mapTicks;
+    std::string window;
+    while (fgets(line, sizeof(line), file))
+    {
+        if (strncmp(line, "window\t", 7) == 0)
+            window = line;
+        else if (strncmp(line, "map\t", 4) == 0)
+        {
+            // map <id> <instance> <name> <count> <total> <max> <buckets...>, times in milliseconds
+            uint32 mapId, instanceId, count, max;
+            unsigned long long total;
+            uint32 buckets[SERVER_TICK_BUCKETS];
+            char name[256];
+            if (sscanf(line, "map\t%u\t%u\t%255[^\t]\t%u\t%llu\t%u\t%u\t%u\t%u\t%u\t%u\t%u\t%u\t%u", &mapId, &instanceId, name,
+                &count, &total, &max, &buckets[0], &buckets[1], &buckets[2], &buckets[3], &buckets[4], &buckets[5], &buckets[6], &buckets[7]) != 14)
+                continue;
+
+            MapTicks& map = mapTicks[(uint64(mapId) << 32) | instanceId];
+            map.count = count;
+            map.total = uint64(total);
+            for (uint8 i = SERVER_TICK_SLOW_BUCKET; i < SERVER_TICK_BUCKETS; ++i)
+                map.slow += buckets[i];
+        }
+    }
+
+    fclose(file);
+
+    // the server rewrites the file every Profiler.DumpInterval
+    if (window == m_lastWindow)
+        return true;
+
+    m_lastWindow = window;
+    ticks.dumps = 1;
+
+    // map figures cover the whole uptime, instances created since the last dump start from zero
+    for (MapTicksMap::const_iterator itr = mapTicks.begin(); itr != mapTicks.end(); ++itr)
+    {
+        MapTicks previous;
+        MapTicksMap::const_iterator old = m_mapTicks.find(itr->first);
+        if (old != m_mapTicks.end() && old->second.count <= itr->second.count)
+            previous = old->second;
+
+        ticks.ticks += itr->second.count - previous.count;
+        ticks.total += itr->second.total - previous.total;
+        ticks.slow += itr->second.slow - previous.slow;
+    }
+
+    m_mapTicks.swap(mapTicks);
+    return true;
+}
+
+char const* SwarmStats::GetRequestName(SwarmRequest request)
+{
+    switch (request)
+    {
+        case SWARM_REQUEST_REALM_LOGIN: return "realm login";
+        case SWARM_REQUEST_WORLD_LOGIN: return "world login";
+        case SWARM_REQUEST_ENTER_WORLD: return "enter world";
+        case SWARM_REQUEST_PING:        return "ping";
+        case SWARM_REQUEST_CHAT:        return "chat";
+        case SWARM_REQUEST_CAST:        return "cast";
+        case SWARM_REQUEST_AUCTION:     return "auction";
+        case SWARM_REQUEST_WHO:         return "who";
+        default:                        return "unknown";
+    }
+}
+
+char const* SwarmStats::GetStateName(SwarmBotState state)
+{
+    switch (state)
+    {
+        case BOT_STATE_WAITING:         return "waiting";
+        case BOT_STATE_LOGGING_IN:      return "logging in";
+        case BOT_STATE_IN_WORLD:        return "in world";
+        case BOT_STATE_FAILED:          return "failed";
+        default:                        return "unknown";
+    }
+}
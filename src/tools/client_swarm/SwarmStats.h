@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SWARM_STATS_H
+#define _SWARM_STATS_H
+
+#include "Common.h"
+
+#include <ace/Thread_Mutex.h>
+#include <map>
+
+enum SwarmBotState
+{
+    BOT_STATE_WAITING       = 0,                            // not started yet
+    BOT_STATE_LOGGING_IN    = 1,                            // realm and world login, character selection
+    BOT_STATE_IN_WORLD      = 2,
+    BOT_STATE_FAILED        = 3,                            // login failed or connection lost
+    MAX_BOT_STATE
+};
+
+enum SwarmRequest
+{
+    SWARM_REQUEST_REALM_LOGIN   = 0,                        // authserver connect until the SRP6 proof is accepted
+    SWARM_REQUEST_WORLD_LOGIN   = 1,                        // worldserver connect until SMSG_AUTH_RESPONSE
+    SWARM_REQUEST_ENTER_WORLD   = 2,                        // CMSG_PLAYER_LOGIN until SMSG_LOGIN_VERIFY_WORLD
+    SWARM_REQUEST_PING          = 3,                        // CMSG_PING until SMSG_PONG
+    SWARM_REQUEST_CHAT          = 4,                        // CMSG_MESSAGECHAT_SAY until our SMSG_MESSAGECHAT
+    SWARM_REQUEST_CAST          = 5,                        // CMSG_CAST_SPELL until SMSG_SPELL_START or SMSG_CAST_FAILED
+    SWARM_REQUEST_AUCTION       = 6,                        // CMSG_AUCTION_LIST_ITEMS until SMSG_AUCTION_LIST_RESULT
+    SWARM_REQUEST_WHO           = 7,                        // CMSG_WHO until SMSG_WHO
+    MAX_SWARM_REQUEST
+};
+
+#define SWARM_LATENCY_BUCKETS 8
+
+// round trip times of one kind of request, in milliseconds
+struct SwarmLatency
+{
+    SwarmLatency() : count(0), timeouts(0), total(0), max(0)
+    {
+        memset(buckets, 0, sizeof(buckets));
+    }
+
+    void Add(uint32 time);
+    void Merge(SwarmLatency const& other);
+    // upper limit of the fastest share of the requests, from the buckets
+    uint32 GetPercentile(uint32 percent) const;
+
+    // upper bound of each bucket, the last one takes everything above the previous limit
+    static uint32 const BucketLimits[SWARM_LATENCY_BUCKETS];
+
+    uint32 count;
+    uint32 timeouts;                                        // no answer within SWARM_REQUEST_TIMEOUT
+    uint64 total;
+    uint32 max;
+    uint32 buckets[SWARM_LATENCY_BUCKETS];
+};
+
+struct SwarmCounters
+{
+    SwarmCounters() : packetsSent(0), bytesSent(0), packetsReceived(0), bytesReceived(0), disconnects(0) {}
+
+    void Merge(SwarmCounters const& other);
+
+    uint64 packetsSent;
+    uint64 bytesSent;
+    uint64 packetsReceived;
+    uint64 bytesReceived;
+    uint32 disconnects;                                     // bots that lost the world connection
+    SwarmLatency latency[MAX_SWARM_REQUEST];
+};
+
+// map update times of the worldserver, taken from its profile dump (Profiler.DumpFile)
+struct SwarmServerTicks
+{
+    SwarmServerTicks() : dumps(0), ticks(0), total(0), slow(0) {}
+
+    uint32 dumps;                                           // dumps read, 0 if the file did not change
+    uint32 ticks;                                           // map updates, all maps
+    uint64 total;                                           // milliseconds
+    uint32 slow;                                            // map updates over 50 ms
+};
+
+/*
+ * Counters shared by the bots of all worker threads. The reporter takes the
+ * counters of every interval and adds them to the totals of the run.
+ */
+class SwarmStats
+{
+    public:
+        explicit SwarmStats(uint32 bots);
+
+        void AddLatency(SwarmRequest request, uint32 time);
+        void AddTimeout(SwarmRequest request);
+        void AddSent(uint32 bytes);
+        void AddReceived(uint32 bytes);
+        void AddDisconnect();
+        void ChangeBotState(SwarmBotState from, SwarmBotState to);
+
+        // hands over the counters since the last call
+        void TakeInterval(SwarmCounters& counters);
+        SwarmCounters GetTotal();
+        void GetBotStates(uint32 (&states)[MAX_BOT_STATE]);
+
+        // map updates of the server since the previous call, false if the file can't be read
+        bool ReadServerTicks(std::string const& fileName, SwarmServerTicks& ticks);
+
+        static char const* GetRequestName(SwarmRequest request);
+        static char const* GetStateName(SwarmBotState state);
+
+    private:
+        struct MapTicks
+        {
+            MapTicks() : count(0), total(0), slow(0) {}
+
+            uint32 count;
+            uint64 total;
+            uint32 slow;
+        };
+
+        // key is (map id << 32) | instance id
+        typedef std::map<uint64, MapTicks> MapTicksMap;
+
+        ACE_Thread_Mutex m_lock;                            // protects the members below
+        SwarmCounters m_interval;
+        SwarmCounters m_total;
+        uint32 m_botStates[MAX_BOT_STATE];
+
+        MapTicksMap m_mapTicks;                             // only used by the reporter
+        std::string m_lastWindow;
+};
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SwarmWorker.h"
+#include "Timer.h"
+
+#include <ace/ACE.h>
+#include <ace/Handle_Set.h>
+#include <ace/OS_NS_poll.h>
+
+// longest wait for input, bounds the delay of the scripted actions
+#define SWARM_WORKER_SLEEP  50
+
+SwarmWorker::SwarmWorker(uint32 worker, SwarmConfig const& config, SwarmStats& stats, bool const volatile& stop) :
+    m_config(config), m_stats(stats), m_stop(stop), m_started(0), m_startTime(0), m_loginRate(0)
+{
+    for (uint32 i = worker; i < config.bots; i += config.threads)
+        m_bots.push_back(new SwarmBot(i, config, stats));
+
+    // 0 logs everyone in at once
+    if (config.loginRate)
+        m_loginRate = std::max<uint32>(1, config.loginRate / config.threads);
+}
+
+SwarmWorker::~SwarmWorker()
+{
+    for (size_t i = 0; i < m_bots.size(); ++i)
+        delete m_bots[i];
+}
+
+void SwarmWorker::run()
+{
+    m_startTime = getMSTime();
+
+    while (!m_stop)
+    {
+        uint32 now = getMSTime();
+        StartBots(now);
+        WaitForInput();
+
+        now = getMSTime();
+        for (size_t i = 0; i < m_started; ++i)
+            m_bots[i]->Update(now);
+    }
+
+    for (size_t i = 0; i < m_started; ++i)
+        m_bots[i]->Disconnect();
+}
+
+void SwarmWorker::StartBots(uint32 now)
+{
+    uint32 due = m_bots.size();
+    if (m_loginRate)
+        due = std::min<uint32>(due, uint32(uint64(getMSTimeDiff(m_startTime, now)) * m_loginRate / IN_MILLISECONDS) + 1);
+
+    // Connect blocks for the realm login, a slow authserver slows the login rate down
+    while (m_started < due && !m_stop)
+        m_bots[m_started++]->Connect();
+}
+
+void SwarmWorker::WaitForInput()
+{
+    std::vector<SwarmBot*> connected;
+    connected.reserve(m_started);
+    for (size_t i = 0; i < m_started; ++i)
+        if (m_bots[i]->GetState() == BOT_STATE_LOGGING_IN || m_bots[i]->GetState() == BOT_STATE_IN_WORLD)
+            connected.push_back(m_bots[i]);
+
+    if (connected.empty())
+    {
+        ACE_Based::Thread::Sleep(SWARM_WORKER_SLEEP);
+        return;
+    }
+
+    ACE_Time_Value timeout(0, SWARM_WORKER_SLEEP * 1000);
+
+#if defined (ACE_HAS_POLL)
+    std::vector<pollfd> handles(connected.size());
+    for (size_t i = 0; i < connected.size(); ++i)
+    {
+        handles[i].fd = connected[i]->GetHandle();
+        handles[i].events = POLLIN;
+        handles[i].revents = 0;
+    }
+
+    if (ACE_OS::poll(&handles[0], handles.size(), timeout) <= 0)
+        return;
+
+    for (size_t i = 0; i < connected.size(); ++i)
+        if (handles[i].revents)
+            connected[i]->HandleInput();
+#else
+    // select is limited to FD_SETSIZE sockets, raise Swarm.Threads for large swarms
+    ACE_Handle_Set handles;
+    for (size_t i = 0; i < connected.size(); ++i)
+        handles.set_bit(connected[i]->GetHandle());
+
+    if (ACE::select(int(handles.max_set()) + 1, &handles, 0, 0, &timeout) <= 0)
+        return;
+
+    for (size_t i = 0; i < connected.size(); ++i)
+        if (handles.is_set(connected[i]->GetHandle()))
+            connected[i]->HandleInput();
+#endif
+}
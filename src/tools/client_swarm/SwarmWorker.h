@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2011-2012 Project SkyFire <http://www.projectskyfire.org/>
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SWARM_WORKER_H
+#define _SWARM_WORKER_H
+
+#include "SwarmBot.h"
+#include "Threading.h"
+
+/*
+ * Drives the bots of one thread: logs them in at the configured rate, waits
+ * for the world sockets to become readable and runs the bot scripts. Bot n
+ * belongs to worker n % Threads.
+ */
+class SwarmWorker : public ACE_Based::Runnable
+{
+    public:
+        SwarmWorker(uint32 worker, SwarmConfig const& config, SwarmStats& stats, bool const volatile& stop);
+        ~SwarmWorker();
+
+        void run();
+
+    private:
+        void StartBots(uint32 now);
+        void WaitForInput();
+
+        SwarmConfig const& m_config;
+        SwarmStats& m_stats;
+        bool const volatile& m_stop;
+
+        std::vector<SwarmBot*> m_bots;
+        uint32 m_started;                                   // bots of m_bots that were logged in
+        uint32 m_startTime;
+        uint32 m_loginRate;                                 // share of Swarm.LoginRate of this worker
+};
+
+#endif